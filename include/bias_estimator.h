@@ -0,0 +1,69 @@
+#ifndef MVMT_BIAS_ESTIMATOR_HPP
+#define MVMT_BIAS_ESTIMATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace mvmt {
+
+/// @brief Tracks the offset a sensor reports when it should read zero, such as a gyroscope's output while the board is
+/// held still. The bias only learns from stretches of samples that stay close to their recent average and within the
+/// largest offset the sensor can have, so deliberate motion, even a steady turn, is never mistaken for offset.
+/// @tparam T The type of the signal, typically an Eigen::Matrix of float
+template <typename T> class BiasEstimator {
+public:
+  T m_bias;                      // The current offset estimate
+  T m_recent;                    // Fast-moving average of recent samples, which stillness is judged against
+  float m_still_threshold;       // Largest distance from the recent average that still counts as holding still
+  float m_max_bias;              // Largest offset the sensor can have - a steady reading beyond it is deliberate motion
+  float m_recent_weight;         // Weight of each new sample in the recent average
+  float m_bias_weight;           // Weight of each still stretch's average in the bias, once the bias has settled
+  std::size_t m_still_needed;    // Consecutive still samples required before the bias learns
+  std::size_t m_still_count;     // Consecutive still samples seen, saturating at m_still_needed
+  std::size_t m_learned_samples; // Samples the bias has learned from, used to average evenly until it settles
+
+public:
+  /// @brief Constructs a BiasEstimator object.
+  /// @param still_threshold The largest deviation from the recent average that counts as still
+  /// @param max_bias The largest offset the sensor can have, such as the zero-rate offset in its datasheet
+  /// @param still_time How long the signal must stay still before the bias learns from it, in seconds
+  /// @param bias_time_constant How quickly a settled bias follows slow drift, in seconds
+  /// @param time_delta The difference in time between two samples of the signal
+  /// @param zero_element The zero point of the signal, typically a zero Eigen::Matrix
+  BiasEstimator(float still_threshold, float max_bias, float still_time, float bias_time_constant, float time_delta,
+                T zero_element) noexcept
+      : m_bias(zero_element), m_recent(zero_element), m_still_threshold(still_threshold), m_max_bias(max_bias),
+        m_recent_weight(std::min(1.0f, 4 * time_delta / still_time)),
+        m_bias_weight(std::min(1.0f, time_delta / bias_time_constant)),
+        m_still_needed(std::max<std::size_t>(1, static_cast<std::size_t>(still_time / time_delta))),
+        m_still_count(0), m_learned_samples(0) {}
+
+  /// @brief Add a new sample, learning from it if the signal has been still for long enough.
+  /// @param measurement The new sample to add
+  void add_measurement(const T &measurement) noexcept {
+    bool still = (measurement - m_recent).norm() < m_still_threshold && m_recent.norm() < m_max_bias;
+    m_recent += (measurement - m_recent) * m_recent_weight;
+    m_still_count = still ? std::min(m_still_count + 1, m_still_needed) : 0;
+    if (m_still_count < m_still_needed) {
+      return;
+    }
+    // Average evenly over the first samples so a fresh estimate settles quickly, then follow drift at a steady rate
+    m_learned_samples++;
+    float weight = std::max(m_bias_weight, 1.0f / m_learned_samples);
+    m_bias += (m_recent - m_bias) * weight;
+  }
+  /// @brief Subtract the estimated bias from a sample.
+  [[nodiscard]] T remove(const T &measurement) const noexcept { return measurement - m_bias; }
+  /// @brief Get the current bias estimate.
+  [[nodiscard]] const T &get_current() const noexcept { return m_bias; }
+  /// @brief Replace the bias estimate, such as with one measured by a dedicated calibration. Later still stretches
+  /// refine it at the settled rate rather than averaging it away.
+  void set_current(const T &bias) noexcept {
+    m_bias = bias;
+    m_learned_samples = std::max<std::size_t>(m_learned_samples, static_cast<std::size_t>(1 / m_bias_weight));
+  }
+};
+
+} // namespace mvmt
+
+#endif
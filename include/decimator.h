@@ -0,0 +1,38 @@
+#ifndef MVMT_DECIMATOR_HPP
+#define MVMT_DECIMATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace mvmt {
+
+/// @brief Paces a multi-rate pipeline, marking every Factor-th sample of a fast input as an output instant. Stages
+/// that must see every sample, such as recursive filters and gyroscope integration, run at the input rate, and
+/// everything after the decimation point runs only at output instants. A GaussianFilter already convolves only when
+/// its output is read, so reading it at output instants makes it a polyphase decimator: each output costs one pass
+/// over the taps, and only the phase of the filter landing on an output instant is ever computed. The bell curve then
+/// doubles as the anti-aliasing filter, provided it is narrow in frequency compared to the output's Nyquist rate.
+class Decimator {
+public:
+  const std::size_t m_factor; // Input samples per output
+  std::size_t m_phase;        // Input samples since the last output instant
+
+public:
+  /// @brief Constructs a Decimator object, whose first output instant is Factor samples away.
+  /// @param factor The number of input samples per output, at least one
+  explicit Decimator(std::size_t factor) noexcept : m_factor(std::max<std::size_t>(1, factor)), m_phase(0) {}
+
+  /// @brief Count a new input sample.
+  /// @return Whether the sample is an output instant
+  bool tick() noexcept {
+    if (++m_phase < m_factor) {
+      return false;
+    }
+    m_phase = 0;
+    return true;
+  }
+};
+
+} // namespace mvmt
+
+#endif
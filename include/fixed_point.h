@@ -0,0 +1,159 @@
+#ifndef MVMT_FIXED_POINT_HPP
+#define MVMT_FIXED_POINT_HPP
+
+#include <ArduinoEigen/Eigen/Core>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace mvmt {
+
+/// @brief Implements a signed fixed-point number, so the motion pipeline can run on integer hardware instead of the
+/// double-precision emulation the ESP32 falls back to. Multiplication rounds to nearest and all arithmetic saturates
+/// rather than wrapping.
+/// @tparam Storage The signed integer type holding the raw value
+/// @tparam Wide A signed integer type at least twice as wide as Storage, used for intermediate products
+/// @tparam FracBits The number of fractional bits in the raw value
+template <typename Storage, typename Wide, int FracBits> class Fixed {
+  static_assert(std::is_signed<Storage>::value && std::is_signed<Wide>::value, "Fixed requires signed storage");
+  static_assert(sizeof(Wide) >= 2 * sizeof(Storage), "Fixed requires a product type twice as wide as its storage");
+
+public:
+  Storage raw;
+
+  static constexpr int FRAC_BITS = FracBits;
+  static constexpr Wide ONE = Wide(1) << FracBits;
+
+  constexpr Fixed() noexcept : raw(0) {}
+  /// @brief Converts a floating-point value to the nearest representable fixed-point value.
+  constexpr explicit Fixed(double value) noexcept : raw(saturate(round_double(value * ONE))) {}
+  /// @brief Converts between fixed-point formats, rounding away dropped fractional bits.
+  template <typename S, typename W, int F>
+  constexpr explicit Fixed(Fixed<S, W, F> other) noexcept : raw(saturate(rescale<F>(other.raw))) {}
+
+  /// @brief Wraps a raw integer that already has FracBits fractional bits.
+  static constexpr Fixed from_raw(Storage raw) noexcept {
+    Fixed result;
+    result.raw = raw;
+    return result;
+  }
+  /// @brief Wraps a raw integer with SrcBits fractional bits, such as a signed sensor reading (which is a fraction of
+  /// full scale with 15 fractional bits).
+  template <int SrcBits> static constexpr Fixed from_fixed(Wide raw) noexcept {
+    return from_raw(saturate(rescale<SrcBits>(raw)));
+  }
+
+  /// @brief Gets the integer part of the value, truncating toward zero like a floating-point cast would.
+  constexpr std::int32_t to_int() const noexcept {
+    return static_cast<std::int32_t>(raw < 0 ? -(-static_cast<Wide>(raw) >> FracBits) : raw >> FracBits);
+  }
+  constexpr double to_double() const noexcept { return static_cast<double>(raw) / ONE; }
+  constexpr explicit operator double() const noexcept { return to_double(); }
+  constexpr explicit operator float() const noexcept { return static_cast<float>(raw) / ONE; }
+
+  constexpr Fixed operator-() const noexcept { return from_raw(saturate(-static_cast<Wide>(raw))); }
+  constexpr Fixed operator+(Fixed rhs) const noexcept {
+    return from_raw(saturate(static_cast<Wide>(raw) + static_cast<Wide>(rhs.raw)));
+  }
+  constexpr Fixed operator-(Fixed rhs) const noexcept {
+    return from_raw(saturate(static_cast<Wide>(raw) - static_cast<Wide>(rhs.raw)));
+  }
+  constexpr Fixed operator*(Fixed rhs) const noexcept {
+    return from_raw(saturate(round_shift(static_cast<Wide>(raw) * static_cast<Wide>(rhs.raw), FracBits)));
+  }
+  constexpr Fixed operator/(Fixed rhs) const noexcept {
+    return from_raw(saturate((static_cast<Wide>(raw) << FracBits) / rhs.raw));
+  }
+  Fixed &operator+=(Fixed rhs) noexcept { return *this = *this + rhs; }
+  Fixed &operator-=(Fixed rhs) noexcept { return *this = *this - rhs; }
+  Fixed &operator*=(Fixed rhs) noexcept { return *this = *this * rhs; }
+  Fixed &operator/=(Fixed rhs) noexcept { return *this = *this / rhs; }
+
+  constexpr bool operator==(Fixed rhs) const noexcept { return raw == rhs.raw; }
+  constexpr bool operator!=(Fixed rhs) const noexcept { return raw != rhs.raw; }
+  constexpr bool operator<(Fixed rhs) const noexcept { return raw < rhs.raw; }
+  constexpr bool operator>(Fixed rhs) const noexcept { return raw > rhs.raw; }
+  constexpr bool operator<=(Fixed rhs) const noexcept { return raw <= rhs.raw; }
+  constexpr bool operator>=(Fixed rhs) const noexcept { return raw >= rhs.raw; }
+
+private:
+  static constexpr Storage saturate(Wide value) noexcept {
+    return value > std::numeric_limits<Storage>::max()   ? std::numeric_limits<Storage>::max()
+           : value < std::numeric_limits<Storage>::min() ? std::numeric_limits<Storage>::min()
+                                                         : static_cast<Storage>(value);
+  }
+  static constexpr Wide round_double(double value) noexcept {
+    // Clamp before converting, since converting an out-of-range double to an integer is undefined
+    return value >= std::numeric_limits<Storage>::max()   ? std::numeric_limits<Storage>::max()
+           : value <= std::numeric_limits<Storage>::min() ? std::numeric_limits<Storage>::min()
+                                                          : static_cast<Wide>(value + (value < 0 ? -0.5 : 0.5));
+  }
+  static constexpr Wide round_shift(Wide value, int shift) noexcept {
+    return shift > 0 ? (value + (Wide(1) << (shift - 1))) >> shift : value;
+  }
+  template <int SrcBits> static constexpr Wide rescale(Wide value) noexcept {
+    if constexpr (SrcBits > FracBits) {
+      return round_shift(value, SrcBits - FracBits);
+    } else {
+      return value * (Wide(1) << (FracBits - SrcBits));
+    }
+  }
+};
+
+/// @brief Signed fraction in [-1, 1) - the native format of the ICM-20948's 16-bit sensor registers
+using Q15 = Fixed<std::int16_t, std::int32_t, 15>;
+/// @brief Signed fraction in [-1, 1) with 16 more bits of precision than Q15
+using Q31 = Fixed<std::int32_t, std::int64_t, 31>;
+/// @brief Signed value in [-32768, 32768) with 16 fractional bits, for quantities that outgrow a fraction
+using Q16 = Fixed<std::int32_t, std::int64_t, 16>;
+
+/// @brief Detects the Fixed template, so generic code can pick integer-friendly code paths.
+template <typename T> struct is_fixed : std::false_type {};
+template <typename S, typename W, int F> struct is_fixed<Fixed<S, W, F>> : std::true_type {};
+
+/// @brief Truncate a motion value toward zero, whatever its numeric representation.
+template <typename T> constexpr std::int32_t to_int(T value) noexcept {
+  if constexpr (is_fixed<T>::value) {
+    return value.to_int();
+  } else {
+    return static_cast<std::int32_t>(value);
+  }
+}
+
+/// @brief Convert a whole number to a motion value, whatever its numeric representation.
+template <typename T> constexpr T from_int(std::int32_t value) noexcept {
+  if constexpr (is_fixed<T>::value) {
+    return T::template from_fixed<0>(value);
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
+} // namespace mvmt
+
+// Teach Eigen to store fixed-point numbers in its vectors
+namespace Eigen {
+template <typename S, typename W, int F>
+struct NumTraits<mvmt::Fixed<S, W, F>> : GenericNumTraits<mvmt::Fixed<S, W, F>> {
+  typedef mvmt::Fixed<S, W, F> Real;
+  typedef mvmt::Fixed<S, W, F> NonInteger;
+  typedef mvmt::Fixed<S, W, F> Literal;
+  typedef mvmt::Fixed<S, W, F> Nested;
+  enum {
+    IsInteger = 0,
+    IsSigned = 1,
+    IsComplex = 0,
+    RequireInitialization = 0,
+    ReadCost = 1,
+    AddCost = 1,
+    MulCost = 2
+  };
+  static inline Real epsilon() { return Real::from_raw(1); }
+  static inline Real dummy_precision() { return Real::from_raw(1); }
+  static inline Real highest() { return Real::from_raw(std::numeric_limits<S>::max()); }
+  static inline Real lowest() { return Real::from_raw(std::numeric_limits<S>::min()); }
+  static inline int digits10() { return 0; }
+};
+} // namespace Eigen
+
+#endif
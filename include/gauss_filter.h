@@ -5,66 +5,396 @@
 // are moved out of this file, linker errors ensue.
 
 #include <ArduinoEigen/Eigen/Dense>
+#include <algorithm>
+#include <array>
 #include <cmath>
-#include <deque>
+#include <type_traits>
 #include <vector>
 
+#include "fixed_point.h"
+
+#if __has_include(<esp_dsp.h>)
+#include <esp_dsp.h>
+#define MVMT_HAS_ESP_DSP
+#endif
+
 namespace mvmt {
 
-/// @brief Implements a Gaussian filter, which works by convolving a bell curve with an input signal.
+/// @brief Get the scalar type of a signal, so that filter weights can share the signal's precision.
+template <typename T, typename = void> struct scalar_of {
+  using type = T;
+};
+template <typename T> struct scalar_of<T, std::void_t<typename T::Scalar>> {
+  using type = typename T::Scalar;
+};
+
+/// @brief Get the number of taps in a truncated bell curve.
+/// @param stddev The standard deviation of the bell curve
+/// @param z_cutoff The number of standard deviations kept on either side of the mean
+/// @param time_delta The difference in time between two taps
+constexpr std::size_t gauss_table_length(double stddev, double z_cutoff, double time_delta) noexcept {
+  return static_cast<std::size_t>(2 * (z_cutoff * stddev) / time_delta);
+}
+
+/// @brief Sample a truncated bell curve and normalize it so its taps sum to one. The first tap is applied to the oldest
+/// sample in a filter window.
+/// @param stddev The standard deviation of the bell curve
+/// @param z_cutoff The number of standard deviations kept on either side of the mean
+/// @param time_delta The difference in time between two taps
+inline std::vector<double> make_gauss_table(double stddev, double z_cutoff, double time_delta) {
+  std::vector<double> gauss_table;
+  std::size_t length = gauss_table_length(stddev, z_cutoff, time_delta);
+  gauss_table.reserve(length);
+  double mean = stddev * z_cutoff;
+  for (std::size_t i = 0; i < length; i++) {
+    auto x = i * time_delta;
+    auto intermediate = exp(-0.5 * pow((x - mean) / stddev, 2));
+    gauss_table.push_back(intermediate / (stddev * sqrt(2 * M_PI)));
+  }
+  double accumulator = 0.0;
+  for (auto val : gauss_table) {
+    accumulator += val;
+  }
+  auto scale_factor = 1.0 / accumulator;
+  for (auto &val : gauss_table) {
+    val *= scale_factor;
+  }
+  return gauss_table;
+}
+
+/// @brief Compute e^x at compile time, since std::exp isn't constexpr. The argument is halved until a short Taylor
+/// series converges, and the result is squared back up.
+constexpr double constexpr_exp(double x) noexcept {
+  int halvings = 0;
+  while (x > 0.5 || x < -0.5) {
+    x /= 2;
+    halvings++;
+  }
+  double term = 1.0;
+  double sum = 1.0;
+  for (int n = 1; n < 16; n++) {
+    term *= x / n;
+    sum += term;
+  }
+  while (halvings-- > 0) {
+    sum *= sum;
+  }
+  return sum;
+}
+
+/// @brief Compile-time counterpart of make_gauss_table(). Assign the result to a constexpr variable to bake the taps
+/// into flash (.rodata) instead of computing them into the heap during static initialization, e.g.
+///   constexpr auto taps = gauss_kernel<double, gauss_table_length(0.025, 2, 0.004)>(0.025, 2, 0.004);
+/// @tparam Tap The type of each tap, matching the scalar type of the filtered signal
+/// @tparam N The number of taps, which must equal gauss_table_length(stddev, z_cutoff, time_delta)
+/// @param stddev The standard deviation of the bell curve
+/// @param z_cutoff The number of standard deviations kept on either side of the mean
+/// @param time_delta The difference in time between two taps
+template <typename Tap, std::size_t N>
+constexpr std::array<Tap, N> gauss_kernel(double stddev, double z_cutoff, double time_delta) noexcept {
+  // The 1 / (stddev * sqrt(2 * pi)) factor of the bell curve cancels out in normalization, so it is skipped
+  double unscaled[N] = {};
+  double accumulator = 0.0;
+  double mean = stddev * z_cutoff;
+  for (std::size_t i = 0; i < N; i++) {
+    double z = (i * time_delta - mean) / stddev;
+    unscaled[i] = constexpr_exp(-0.5 * z * z);
+    accumulator += unscaled[i];
+  }
+  std::array<Tap, N> gauss_table = {};
+  for (std::size_t i = 0; i < N; i++) {
+    gauss_table[i] = static_cast<Tap>(unscaled[i] / accumulator);
+  }
+  return gauss_table;
+}
+
+/// @brief Filter policy: convolve the signal with a truncated, sampled bell curve. Cost per sample grows linearly with
+/// the width of the bell curve.
+struct FiniteImpulse {};
+
+/// @brief Filter policy: approximate the bell curve with the third-order recursive filter of Young and van Vliet. Cost
+/// per sample is constant regardless of the width of the bell curve.
+struct RecursiveImpulse {};
+
+/// @brief Filter policy: the same convolution as FiniteImpulse, but in single precision over one contiguous array per
+/// axis, so each axis can be run through Espressif's esp-dsp dot product kernels. Falls back to a plain loop on builds
+/// without esp-dsp. Only available for Eigen column vectors of float.
+struct DspImpulse {};
+
+/// @brief Implements a Gaussian filter, which smooths an input signal with a bell curve.
 /// @tparam T The type of the signal, typically either a floating-point number or an Eigen::Matrix
-template <typename T> class GaussianFilter {
+/// @tparam Mode One of FiniteImpulse, RecursiveImpulse or DspImpulse, selecting how the bell curve is applied
+template <typename T, typename Mode = FiniteImpulse> class GaussianFilter;
+
+/// @brief Implements a Gaussian filter, which works by convolving a bell curve with an input signal.
+/// @tparam T The type of the signal, typically either a floating-point number or an Eigen::Matrix. Filter weights are
+/// stored with the signal's scalar type, so a float or fixed-point signal never touches double precision per sample.
+template <typename T> class GaussianFilter<T, FiniteImpulse> {
+  using tap_t = typename scalar_of<T>::type;
+
 public:
-  std::deque<T> m_buffer;
+  std::vector<T> m_buffer; // Circular buffer of samples, allocated once at construction
   const std::size_t m_buffer_length;
-  std::vector<double> m_gauss_table;
+  std::size_t m_head;               // Index of the oldest sample, which is also the next slot to be overwritten
+  std::size_t m_count;              // Number of samples held in the buffer, saturating at m_buffer_length
+  std::vector<tap_t> m_gauss_table; // Taps computed at runtime; empty if the taps were baked in at compile time
+  const tap_t *m_taps;              // The taps in use, pointing into either m_gauss_table or a baked table
   const T m_zero_element;
 
 public:
-  /// @brief Constructs a GaussianFilter object.
+  /// @brief Constructs a GaussianFilter object, computing the bell curve at runtime.
   /// @param stddev The standard deviation of the bell curve to be used
   /// @param z_cutoff The number of standard deviations to lag behind the input signal
   /// @param time_delta The difference in time between two samples of the input signal
   /// @param zero_element The zero point of the input type, typically either 0.0 or a zero Eigen::Matrix
   GaussianFilter(double stddev, double z_cutoff, double time_delta, T zero_element) noexcept
-      : m_buffer_length(2 * (z_cutoff * stddev) / time_delta), m_zero_element(zero_element) {
-    double mean = stddev * z_cutoff;
-    for (std::size_t i = 0; i < m_buffer_length; i++) {
-      auto x = i * time_delta;
-      auto intermediate = exp(-0.5 * pow((x - mean) / stddev, 2));
-      m_gauss_table.push_back(intermediate / (stddev * sqrt(2 * M_PI)));
+      : m_buffer(gauss_table_length(stddev, z_cutoff, time_delta), zero_element), m_buffer_length(m_buffer.size()),
+        m_head(0), m_count(0), m_zero_element(zero_element) {
+    m_gauss_table.reserve(m_buffer_length);
+    for (auto val : make_gauss_table(stddev, z_cutoff, time_delta)) {
+      m_gauss_table.push_back(static_cast<tap_t>(val));
+    }
+    m_taps = m_gauss_table.data();
+  }
+  /// @brief Constructs a GaussianFilter object around a bell curve baked in at compile time by gauss_kernel().
+  /// @param gauss_table The taps to convolve with, which must outlive the filter
+  /// @param zero_element The zero point of the input type, typically either 0.0 or a zero Eigen::Matrix
+  template <std::size_t N>
+  GaussianFilter(const std::array<tap_t, N> &gauss_table, T zero_element) noexcept
+      : m_buffer(N, zero_element), m_buffer_length(N), m_head(0), m_count(0), m_taps(gauss_table.data()),
+        m_zero_element(zero_element) {}
+  // m_taps may point into this object, so copies would share a dangling pointer
+  GaussianFilter(const GaussianFilter &) = delete;
+  GaussianFilter &operator=(const GaussianFilter &) = delete;
+
+  /// @brief Add a new sample to the filter's buffer.
+  /// @param measurement The new sample to add
+  void add_measurement(T measurement) noexcept {
+    m_buffer[m_head] = measurement;
+    if (++m_head == m_buffer_length) {
+      m_head = 0;
+    }
+    if (m_count < m_buffer_length) {
+      m_count++;
+    }
+  }
+  /// @brief Add a batch of consecutive samples to the filter's buffer in one pass, as if by repeated calls to
+  /// add_measurement(). Samples too old to reach the filter window are skipped.
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  void add_measurements(const T *measurements, std::size_t count) noexcept {
+    if (count > m_buffer_length) {
+      // Skipped samples still move the head, so the window is laid out exactly as repeated add_measurement() calls
+      // would leave it
+      m_head = (m_head + count - m_buffer_length) % m_buffer_length;
+      measurements += count - m_buffer_length;
+      count = m_buffer_length;
     }
-    double accumulator = 0.0;
-    for (auto val : m_gauss_table) {
-      accumulator += val;
+    for (std::size_t i = 0; i < count; i++) {
+      m_buffer[m_head] = measurements[i];
+      if (++m_head == m_buffer_length) {
+        m_head = 0;
+      }
     }
-    auto scale_factor = 1.0 / accumulator;
-    for (auto &val : m_gauss_table) {
-      val *= scale_factor;
+    m_count = m_count + count < m_buffer_length ? m_count + count : m_buffer_length;
+  }
+  /// @brief Get the current output of the filter.
+  /// @return The current output value of the filter; if the filter buffer is not yet full, returns the latest
+  /// unfiltered sample
+  [[nodiscard]] T get_current() const noexcept {
+    // if buffer is underfilled, return the most recent sample
+    if (m_count < m_buffer_length) {
+      return m_count ? m_buffer[m_count - 1] : m_zero_element;
     }
+    // convolve! The oldest sample sits at m_head, so the window wraps around the end of the buffer - walk it as two
+    // contiguous segments rather than taking a modulo per tap
+    const std::size_t first_segment = m_buffer_length - m_head;
+    T accumulator = m_zero_element;
+    for (std::size_t i = 0; i < first_segment; i++) {
+      accumulator += m_taps[i] * m_buffer[m_head + i];
+    }
+    for (std::size_t i = 0; i < m_head; i++) {
+      accumulator += m_taps[first_segment + i] * m_buffer[i];
+    }
+    return accumulator;
   }
+};
+
+/// @brief Implements a Gaussian filter as a causal recursive (IIR) approximation, after Young and van Vliet, "Recursive
+/// implementation of the Gaussian filter" (1995). Only the past three outputs are kept, so the filter does the same
+/// amount of work per sample no matter how wide the bell curve is.
+/// @tparam T The type of the signal, typically either a floating-point number or an Eigen::Matrix
+template <typename T> class GaussianFilter<T, RecursiveImpulse> {
+  using tap_t = typename scalar_of<T>::type;
+  // The feedback weights exceed one and the state must settle to within a fraction of an LSB, which fixed-point
+  // fractions can't do
+  static_assert(!is_fixed<tap_t>::value, "The recursive Gaussian filter requires a floating-point signal");
+  static constexpr double MIN_SIGMA = 0.5; // Narrowest bell curve, in samples, that the recursive fit holds for
+
+public:
+  T m_w1, m_w2, m_w3;     // The three most recent filter outputs, newest first
+  bool m_primed;          // Whether the filter state has been seeded with a sample
+  tap_t m_gain;           // Weight of the incoming sample (B in the paper)
+  tap_t m_a1, m_a2, m_a3; // Feedback weights (b1/b0, b2/b0, b3/b0 in the paper)
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs a GaussianFilter object.
+  /// @param stddev The standard deviation of the bell curve to be used
+  /// @param z_cutoff Ignored: the recursive filter's response never ends, so there is no tail to cut off. The parameter
+  /// is kept so that switching between FiniteImpulse and RecursiveImpulse only changes the Mode argument
+  /// @param time_delta The difference in time between two samples of the input signal
+  /// @param zero_element The zero point of the input type, typically either 0.0 or a zero Eigen::Matrix
+  GaussianFilter(double stddev, double z_cutoff, double time_delta, T zero_element) noexcept
+      : m_w1(zero_element), m_w2(zero_element), m_w3(zero_element), m_primed(false), m_zero_element(zero_element) {
+    (void)z_cutoff;
+    // Young and van Vliet's empirical fit from the bell curve's width (in samples) to the filter parameter q. The fit
+    // only holds from half a sample up - below that q shrinks toward zero and then goes negative, making the filter
+    // unstable - so narrower bell curves are widened to half a sample, which barely smooths at all
+    double sigma = std::max(stddev / time_delta, MIN_SIGMA);
+    double q = sigma >= 2.5 ? 0.98711 * sigma - 0.96330 : 3.97156 - 4.14554 * sqrt(1.0 - 0.26891 * sigma);
+    double q2 = q * q;
+    double q3 = q2 * q;
+    double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    double a1 = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+    double a2 = -(1.4281 * q2 + 1.26661 * q3) / b0;
+    double a3 = 0.422205 * q3 / b0;
+    m_a1 = static_cast<tap_t>(a1);
+    m_a2 = static_cast<tap_t>(a2);
+    m_a3 = static_cast<tap_t>(a3);
+    m_gain = static_cast<tap_t>(1.0 - (a1 + a2 + a3));
+  }
+
+  /// @brief Add a new sample to the filter's state.
+  /// @param measurement The new sample to add
+  void add_measurement(T measurement) noexcept {
+    // Seed the state with the first sample so the output doesn't ramp up from zero
+    if (!m_primed) {
+      m_w1 = m_w2 = m_w3 = measurement;
+      m_primed = true;
+      return;
+    }
+    T next = m_gain * measurement + m_a1 * m_w1 + m_a2 * m_w2 + m_a3 * m_w3;
+    m_w3 = m_w2;
+    m_w2 = m_w1;
+    m_w1 = next;
+  }
+  /// @brief Add a batch of consecutive samples to the filter's state, as if by repeated calls to add_measurement().
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  void add_measurements(const T *measurements, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; i++) {
+      add_measurement(measurements[i]);
+    }
+  }
+  /// @brief Get the current output of the filter.
+  /// @return The current output value of the filter; if no samples have been added yet, returns the zero element
+  [[nodiscard]] T get_current() const noexcept { return m_primed ? m_w1 : m_zero_element; }
+};
+
+/// @brief Implements a Gaussian filter by convolution, storing the window of each axis as its own contiguous float ring
+/// buffer so the convolution maps onto vectorized dot products.
+/// @tparam Rows The number of axes in the signal
+template <int Rows> class GaussianFilter<Eigen::Matrix<float, Rows, 1>, DspImpulse> {
+  using T = Eigen::Matrix<float, Rows, 1>;
+
+public:
+  const std::size_t m_buffer_length;
+  std::vector<float> m_buffer;      // Axis-major ring buffers: axis k occupies [k * m_buffer_length, (k + 1) * ...)
+  std::size_t m_head;               // Index of the oldest sample, which is also the next slot to be overwritten
+  std::size_t m_count;              // Number of samples held in the buffer, saturating at m_buffer_length
+  std::vector<float> m_gauss_table; // Taps computed at runtime; empty if the taps were baked in at compile time
+  const float *m_taps;              // The taps in use, pointing into either m_gauss_table or a baked table
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs a GaussianFilter object, computing the bell curve at runtime.
+  /// @param stddev The standard deviation of the bell curve to be used
+  /// @param z_cutoff The number of standard deviations to lag behind the input signal
+  /// @param time_delta The difference in time between two samples of the input signal
+  /// @param zero_element The zero point of the input type, typically a zero Eigen::Matrix
+  GaussianFilter(double stddev, double z_cutoff, double time_delta, T zero_element) noexcept
+      : m_buffer_length(gauss_table_length(stddev, z_cutoff, time_delta)), m_buffer(Rows * m_buffer_length, 0.0f),
+        m_head(0), m_count(0), m_zero_element(zero_element) {
+    auto gauss_table = make_gauss_table(stddev, z_cutoff, time_delta);
+    m_gauss_table.assign(gauss_table.begin(), gauss_table.end());
+    m_taps = m_gauss_table.data();
+  }
+  /// @brief Constructs a GaussianFilter object around a bell curve baked in at compile time by gauss_kernel().
+  /// @param gauss_table The taps to convolve with, which must outlive the filter
+  /// @param zero_element The zero point of the input type, typically a zero Eigen::Matrix
+  template <std::size_t N>
+  GaussianFilter(const std::array<float, N> &gauss_table, T zero_element) noexcept
+      : m_buffer_length(N), m_buffer(Rows * N, 0.0f), m_head(0), m_count(0), m_taps(gauss_table.data()),
+        m_zero_element(zero_element) {}
+  // m_taps may point into this object, so copies would share a dangling pointer
+  GaussianFilter(const GaussianFilter &) = delete;
+  GaussianFilter &operator=(const GaussianFilter &) = delete;
 
   /// @brief Add a new sample to the filter's buffer.
   /// @param measurement The new sample to add
   void add_measurement(T measurement) noexcept {
-    if (m_buffer.size() >= m_buffer_length) {
-      m_buffer.pop_front();
+    for (int k = 0; k < Rows; k++) {
+      m_buffer[k * m_buffer_length + m_head] = measurement[k];
+    }
+    if (++m_head == m_buffer_length) {
+      m_head = 0;
+    }
+    if (m_count < m_buffer_length) {
+      m_count++;
+    }
+  }
+  /// @brief Add a batch of consecutive samples to the filter's buffer in one pass, as if by repeated calls to
+  /// add_measurement(). Samples too old to reach the filter window are skipped.
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  void add_measurements(const T *measurements, std::size_t count) noexcept {
+    if (count > m_buffer_length) {
+      // Skipped samples still move the head, so the window is laid out exactly as repeated add_measurement() calls
+      // would leave it
+      m_head = (m_head + count - m_buffer_length) % m_buffer_length;
+      measurements += count - m_buffer_length;
+      count = m_buffer_length;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+      add_measurement(measurements[i]);
     }
-    m_buffer.push_back(measurement);
   }
   /// @brief Get the current output of the filter.
   /// @return The current output value of the filter; if the filter buffer is not yet full, returns the latest
   /// unfiltered sample
   [[nodiscard]] T get_current() const noexcept {
-    // if queue is underfilled, return current back of queue
-    if (m_buffer.size() < m_buffer_length) {
-      return m_buffer.back();
+    T result = m_zero_element;
+    // if buffer is underfilled, return the most recent sample
+    if (m_count < m_buffer_length) {
+      if (m_count) {
+        for (int k = 0; k < Rows; k++) {
+          result[k] = m_buffer[k * m_buffer_length + m_count - 1];
+        }
+      }
+      return result;
     }
-    // convolve!
-    T accumulator = m_zero_element;
-    for (std::size_t i = 0; i < m_buffer_length; i++) {
-      accumulator += m_gauss_table[i] * m_buffer[i];
+    // convolve each axis as two contiguous segments, as in the FiniteImpulse mode
+    const std::size_t first_segment = m_buffer_length - m_head;
+    for (int k = 0; k < Rows; k++) {
+      const float *axis = m_buffer.data() + k * m_buffer_length;
+      result[k] = dot(m_taps, axis + m_head, first_segment) + dot(m_taps + first_segment, axis, m_head);
+    }
+    return result;
+  }
+
+private:
+  static float dot(const float *lhs, const float *rhs, std::size_t length) noexcept {
+    float accumulator = 0.0f;
+#ifdef MVMT_HAS_ESP_DSP
+    if (length) {
+      dsps_dotprod_f32(lhs, rhs, &accumulator, length);
+    }
+#else
+    for (std::size_t i = 0; i < length; i++) {
+      accumulator += lhs[i] * rhs[i];
     }
+#endif
     return accumulator;
   }
 };
@@ -0,0 +1,149 @@
+#ifndef MVMT_GESTURE_CLASSIFIER_HPP
+#define MVMT_GESTURE_CLASSIFIER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace mvmt {
+
+/// @brief The gestures a GestureClassifier recognizes, in the order of its model's outputs.
+enum class Gesture : std::uint8_t { NONE, FLICK_LEFT, TWIST, SHAKE };
+
+/// @brief The weights of a quantized multilayer perceptron with one hidden layer, as written by
+/// tools/train_gestures.py. Weights and activations are signed 8-bit integers sharing one scale per layer, and biases
+/// are 32-bit integers at the scale of the products they are added to, so a layer is integer multiply-accumulates
+/// followed by a single rescale.
+/// @tparam Inputs The number of features the network takes
+/// @tparam Hidden The number of neurons in the hidden layer
+/// @tparam Outputs The number of classes the network scores
+template <std::size_t Inputs, std::size_t Hidden, std::size_t Outputs> struct GestureModel {
+  std::array<std::int32_t, Inputs> input_offset;                     // Subtracted from each feature
+  std::array<std::int32_t, Inputs> input_scale;                      // Takes each offset feature to 8 bits, in Q16
+  std::array<std::array<std::int8_t, Inputs>, Hidden> hidden_weights; // One row of weights per hidden neuron
+  std::array<std::int32_t, Hidden> hidden_bias;
+  std::int32_t hidden_multiplier; // Takes the hidden accumulators to 8 bits, in Q(hidden_shift)
+  int hidden_shift;
+  std::array<std::array<std::int8_t, Hidden>, Outputs> output_weights; // One row of weights per class
+  std::array<std::int32_t, Outputs> output_bias;
+  std::int32_t margin; // Least lead of the best class's score over the next best for the network to decide
+};
+
+/// @brief Multiply a vector of 8-bit values by a matrix of 8-bit weights, accumulating in 32 bits.
+/// @param weights The weights, one row per output
+/// @param bias The value each accumulator starts from
+/// @param input The vector to multiply
+/// @param output The accumulators, one per output
+template <std::size_t In, std::size_t Out>
+void dense_int8(const std::array<std::array<std::int8_t, In>, Out> &weights, const std::array<std::int32_t, Out> &bias,
+                const std::array<std::int8_t, In> &input, std::array<std::int32_t, Out> &output) noexcept {
+  for (std::size_t o = 0; o < Out; o++) {
+    std::int32_t sum = bias[o];
+    for (std::size_t i = 0; i < In; i++) {
+      sum += std::int32_t(weights[o][i]) * input[i];
+    }
+    output[o] = sum;
+  }
+}
+
+/// @brief Rescale a 32-bit value by multiplier / 2^shift, rounding to nearest, and saturate it to a range of 8-bit
+/// values.
+template <std::int32_t Low, std::int32_t High>
+constexpr std::int8_t requantize(std::int32_t value, std::int32_t multiplier, int shift) noexcept {
+  std::int64_t scaled = (std::int64_t(value) * multiplier + (std::int64_t(1) << (shift - 1))) >> shift;
+  return std::int8_t(std::clamp<std::int64_t>(scaled, Low, High));
+}
+
+/// @brief Recognizes gestures from a window's features with a small quantized neural network. All the arithmetic is
+/// integer, and the network is fixed in size, so every window costs the same: one rescale per feature, Inputs *
+/// Hidden + Hidden * Outputs 8-bit multiply-accumulates, and one rescale per hidden neuron.
+/// @tparam Inputs The number of features the network takes
+/// @tparam Hidden The number of neurons in the hidden layer
+/// @tparam Outputs The number of classes the network scores, the first of which means no gesture
+template <std::size_t Inputs, std::size_t Hidden, std::size_t Outputs> class GestureClassifier {
+public:
+  using model_t = GestureModel<Inputs, Hidden, Outputs>;
+
+  const model_t &m_model;                    // The trained network
+  std::array<std::int8_t, Inputs> m_input;   // The latest features, quantized
+  std::array<std::int32_t, Hidden> m_hidden; // The hidden layer's accumulators
+  std::array<std::int8_t, Hidden> m_active;  // The hidden layer's outputs, quantized
+  std::array<std::int32_t, Outputs> m_score; // Each class's score for the latest features
+
+public:
+  /// @brief Constructs a GestureClassifier object.
+  /// @param model The trained network, which must outlive the classifier
+  explicit GestureClassifier(const model_t &model) noexcept
+      : m_model(model), m_input(), m_hidden(), m_active(), m_score() {}
+
+  /// @brief Classify a window's features.
+  /// @param features The features, in the units GestureFeatures gives them
+  /// @return The index of the best scoring class, or zero unless it leads the next best by the model's margin
+  template <typename Features> std::size_t classify(const Features &features) noexcept {
+    for (std::size_t i = 0; i < Inputs; i++) {
+      m_input[i] = requantize<-128, 127>(features[i] - m_model.input_offset[i], m_model.input_scale[i], 16);
+    }
+    dense_int8(m_model.hidden_weights, m_model.hidden_bias, m_input, m_hidden);
+    for (std::size_t h = 0; h < Hidden; h++) {
+      // Rectifying is folded into the rescale by saturating at zero
+      m_active[h] = requantize<0, 127>(m_hidden[h], m_model.hidden_multiplier, m_model.hidden_shift);
+    }
+    dense_int8(m_model.output_weights, m_model.output_bias, m_active, m_score);
+    std::size_t best = 0;
+    std::int32_t runner_up = std::numeric_limits<std::int32_t>::min();
+    for (std::size_t o = 1; o < Outputs; o++) {
+      if (m_score[o] > m_score[best]) {
+        runner_up = m_score[best];
+        best = o;
+      } else {
+        runner_up = std::max(runner_up, m_score[o]);
+      }
+    }
+    return std::int64_t(m_score[best]) - runner_up >= m_model.margin ? best : 0;
+  }
+};
+
+/// @brief Turns the classes recognized in a stream of overlapping windows into single gestures. A gesture spans several
+/// windows, so it only fires once enough consecutive windows agree on it, which also ignores a stray window, and
+/// windows recognizing no gesture must come between it and the next.
+class GestureTrigger {
+public:
+  const std::size_t m_confirm_limit; // Consecutive windows that must agree on a gesture for it to fire
+  const std::size_t m_rearm_limit;   // Windows of no gesture needed after one fires before another can
+  std::size_t m_last;                // Class of the latest window
+  std::size_t m_run;                 // Consecutive windows recognizing m_last
+  std::size_t m_idle;                // Consecutive windows recognizing no gesture, saturating at m_rearm_limit
+  bool m_armed;                      // Whether a gesture can fire
+
+public:
+  /// @brief Constructs a GestureTrigger object, which is armed from the start.
+  /// @param confirm_windows Consecutive windows that must agree on a gesture for it to fire
+  /// @param rearm_windows Windows of no gesture needed after one fires before another can
+  GestureTrigger(std::size_t confirm_windows, std::size_t rearm_windows) noexcept
+      : m_confirm_limit(std::max<std::size_t>(1, confirm_windows)), m_rearm_limit(rearm_windows), m_last(0), m_run(0),
+        m_idle(0), m_armed(true) {}
+
+  /// @brief Add the class recognized in a new window.
+  /// @param recognized The class, zero for no gesture
+  /// @return The gesture that fired, or zero if none did
+  std::size_t add_measurement(std::size_t recognized) noexcept {
+    m_run = recognized == m_last ? m_run + 1 : 1;
+    m_last = recognized;
+    if (!recognized) {
+      m_idle = std::min(m_idle + 1, m_rearm_limit);
+      m_armed |= m_idle >= m_rearm_limit;
+      return 0;
+    }
+    m_idle = 0;
+    if (!m_armed || m_run < m_confirm_limit)
+      return 0;
+    m_armed = false;
+    return recognized;
+  }
+};
+
+} // namespace mvmt
+
+#endif
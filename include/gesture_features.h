@@ -0,0 +1,158 @@
+#ifndef MVMT_GESTURE_FEATURES_HPP
+#define MVMT_GESTURE_FEATURES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace mvmt {
+
+/// @brief Get the integer square root of a non-negative number, rounded down, in a fixed 16 steps.
+constexpr std::uint32_t isqrt(std::uint32_t value) noexcept {
+  std::uint32_t root = 0;
+  for (std::uint32_t bit = std::uint32_t(1) << 30; bit; bit >>= 2) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+  }
+  return root;
+}
+
+/// @brief Summarizes a sliding window of raw accelerometer and gyroscope samples as a handful of integer features, for
+/// a classifier to recognize gestures from. Raw samples are first averaged down to a slower, fixed rate, which both
+/// filters out aliasing and makes the features the same whatever rate the IMU samples at. Every channel keeps running
+/// sums over the window, so each new sample costs a few additions however long the window is, and a new set of
+/// features costs one pass over the channels every Hop samples:
+/// - the mean, holding gravity for the accelerometer and the steady rate of turning for the gyroscope
+/// - the standard deviation, which grows with any motion
+/// - the mean change between consecutive samples, which grows with sharp, fast motion such as shaking
+/// - the trend, the mean of the newer half of the window less that of the older half, which gives motion a direction
+/// Everything is integer arithmetic, so the features are bit-for-bit the same on the host that trains a classifier from
+/// recorded samples as on the board.
+/// @tparam Window The number of decimated samples the features summarize
+/// @tparam Hop The number of decimated samples between sets of features
+template <std::size_t Window, std::size_t Hop> class GestureFeatures {
+  static_assert(Window >= 4 && Window % 2 == 0, "A gesture window needs an even number of samples, at least four");
+  // Decimated samples stay within +/-4096, so the running sums of squares fit in 32 bits
+  static_assert(Window <= 64, "A gesture window of more than 64 samples would overflow its running sums");
+  static_assert(Hop > 0 && Hop <= Window, "Gesture windows must overlap or touch");
+
+public:
+  static constexpr std::size_t CHANNELS = 6;           // Accelerometer x, y and z, then gyroscope x, y and z
+  static constexpr std::size_t FEATURES = 4 * CHANNELS; // Means, then deviations, then changes, then trends
+  using sample_t = std::array<std::int16_t, CHANNELS>;
+  using features_t = std::array<std::int32_t, FEATURES>;
+
+  static constexpr int SAMPLE_SHIFT = 4; // Bits dropped from raw counts, leaving 1024 counts per g at +/-2 g
+
+  std::array<sample_t, Window> m_window;            // Ring buffer of the latest decimated samples
+  std::array<std::int32_t, CHANNELS> m_sum;         // Sum of each channel over the window
+  std::array<std::int32_t, CHANNELS> m_square_sum;  // Sum of the squares of each channel over the window
+  std::array<std::int32_t, CHANNELS> m_change_sum;  // Sum of the absolute changes between consecutive samples
+  std::array<std::int32_t, CHANNELS> m_recent_sum;  // Sum of each channel over the newer half of the window
+  std::array<std::int32_t, CHANNELS> m_accumulator; // Sum of the raw samples towards the next decimated one
+  features_t m_features;                            // Features of the latest complete window
+  const std::size_t m_decimation;                   // Raw samples averaged into each decimated sample
+  const int m_gyro_shift;                           // Bits the gyroscope is scaled up by, to read as at +/-250 dps
+  std::size_t m_phase;                              // Raw samples accumulated towards the next decimated sample
+  std::size_t m_head;                               // Index in m_window of the oldest decimated sample
+  std::size_t m_count;                              // Decimated samples in the window, saturating at Window
+  std::size_t m_hop;                                // Decimated samples since the latest set of features, once full
+  bool m_decimated;                                 // Whether the latest raw sample completed a decimated one
+
+public:
+  /// @brief Constructs a GestureFeatures object.
+  /// @param decimation The number of raw samples averaged into each decimated sample
+  /// @param gyro_shift The number of bits to scale gyroscope counts up by, so they read as at +/-250 dps: zero at
+  /// +/-250 dps, and one at +/-500 dps
+  GestureFeatures(std::size_t decimation, int gyro_shift) noexcept
+      : m_window(), m_sum(), m_square_sum(), m_change_sum(), m_recent_sum(), m_accumulator(), m_features(),
+        m_decimation(std::max<std::size_t>(1, decimation)), m_gyro_shift(gyro_shift), m_phase(0), m_head(0),
+        m_count(0), m_hop(0), m_decimated(false) {}
+
+  /// @brief Add a raw sample.
+  /// @param raw The raw accelerometer counts at +/-2 g, then the raw gyroscope counts
+  /// @return Whether the sample completed a window, whose features get_current() now returns
+  bool add_measurement(const sample_t &raw) noexcept {
+    for (std::size_t c = 0; c < CHANNELS; c++) {
+      m_accumulator[c] += c < 3 ? raw[c] : raw[c] * (1 << m_gyro_shift);
+    }
+    m_decimated = ++m_phase == m_decimation;
+    if (!m_decimated)
+      return false;
+    sample_t sample;
+    const std::int32_t divisor = std::int32_t(m_decimation) << SAMPLE_SHIFT;
+    for (std::size_t c = 0; c < CHANNELS; c++) {
+      sample[c] = std::int16_t(std::clamp(m_accumulator[c] / divisor, -SAMPLE_LIMIT, SAMPLE_LIMIT));
+      m_accumulator[c] = 0;
+    }
+    m_phase = 0;
+    return add_sample(sample);
+  }
+  /// @brief Add a sample that has already been decimated, such as one recorded by latest().
+  /// @return Whether the sample completed a window, whose features get_current() now returns
+  bool add_sample(const sample_t &sample) noexcept {
+    const std::size_t newest = (m_head + m_count - 1) % Window;
+    const std::size_t half = (m_head + m_count - Window / 2) % Window; // Oldest sample of the newer half, once full
+    for (std::size_t c = 0; c < CHANNELS; c++) {
+      std::int32_t value = sample[c];
+      if (m_count == Window) {
+        // The oldest sample leaves the window, and the middle one leaves its newer half
+        std::int32_t oldest = m_window[m_head][c];
+        m_sum[c] -= oldest;
+        m_square_sum[c] -= oldest * oldest;
+        m_change_sum[c] -= std::abs(m_window[(m_head + 1) % Window][c] - oldest);
+        m_recent_sum[c] -= m_window[half][c];
+      } else if (m_count >= Window / 2) {
+        m_recent_sum[c] -= m_window[half][c];
+      }
+      m_sum[c] += value;
+      m_square_sum[c] += value * value;
+      m_recent_sum[c] += value;
+      if (m_count)
+        m_change_sum[c] += std::abs(value - m_window[newest][c]);
+    }
+    if (m_count == Window) {
+      m_window[m_head] = sample;
+      m_head = (m_head + 1) % Window;
+    } else {
+      m_window[(m_head + m_count++) % Window] = sample;
+    }
+    if (m_count < Window)
+      return false;
+    // The first set of features comes as soon as the window fills, and then every Hop samples
+    bool ready = m_hop == 0;
+    m_hop = (m_hop + 1) % Hop;
+    if (ready)
+      extract();
+    return ready;
+  }
+  /// @brief Get the features of the latest complete window.
+  [[nodiscard]] const features_t &get_current() const noexcept { return m_features; }
+  /// @brief Get the latest decimated sample, such as to record it for training.
+  [[nodiscard]] const sample_t &latest() const noexcept { return m_window[(m_head + m_count - 1) % Window]; }
+
+private:
+  static constexpr std::int32_t SAMPLE_LIMIT = 4096; // Largest magnitude of a decimated sample
+
+  void extract() noexcept {
+    constexpr std::int32_t HALF = Window / 2;
+    for (std::size_t c = 0; c < CHANNELS; c++) {
+      std::int32_t mean = m_sum[c] / std::int32_t(Window);
+      std::int32_t variance = m_square_sum[c] / std::int32_t(Window) - mean * mean;
+      m_features[c] = mean;
+      m_features[CHANNELS + c] = std::int32_t(isqrt(std::uint32_t(std::max<std::int32_t>(0, variance))));
+      m_features[2 * CHANNELS + c] = m_change_sum[c] / std::int32_t(Window - 1);
+      m_features[3 * CHANNELS + c] = (2 * m_recent_sum[c] - m_sum[c]) / HALF;
+    }
+  }
+};
+
+} // namespace mvmt
+
+#endif
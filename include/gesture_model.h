@@ -0,0 +1,62 @@
+#ifndef MVMT_GESTURE_MODEL_HPP
+#define MVMT_GESTURE_MODEL_HPP
+
+// Generated by tools/train_gestures.py from 4060 windows of synthetic traces - retrain rather than edit
+// PLACEHOLDER: this model has only seen synthetic gestures, never ones recorded on the board, so expect it to
+// miss real gestures and mistake ordinary motion for them until it is retrained from recorded traces
+
+#include "gesture_classifier.h"
+#include "gesture_features.h"
+
+namespace mvmt {
+
+constexpr std::size_t GESTURE_WINDOW = 32; // Decimated samples each set of features summarizes
+constexpr std::size_t GESTURE_HOP = 8;     // Decimated samples between sets of features
+constexpr std::size_t GESTURE_HIDDEN = 16; // Neurons in the classifier's hidden layer
+using GestureFeatureExtractor = GestureFeatures<GESTURE_WINDOW, GESTURE_HOP>;
+using GestureNetwork = GestureClassifier<GestureFeatureExtractor::FEATURES, GESTURE_HIDDEN, 4>;
+
+constexpr GestureNetwork::model_t GESTURE_MODEL = {
+    // input_offset
+    {{-9, -32, 937, 0, 0, 7, 193, 35, 58, 65, 182, 240, 64, 11, 5, 53, 68, 73, 0, 0, 0, 0, 0, 0}},
+    // input_scale
+    {{8665, 9373, 10885, 20474, 9671, 14967, 7738, 37363, 24780, 33188, 6153, 5613, 16857, 84293, 191187, 69662,
+        43345, 16465, 9520, 35962, 14420, 19240, 4070, 5592}},
+    // hidden_weights
+    {{
+      {{60, 9, 54, -41, 1, -1, 4, -52, -14, 14, -33, 17, 2, -34, -80, 33, 36, 27, -21, 38, -11, 3, -17, -2}},
+      {{-70, 1, -37, -5, -8, -10, 54, 73, -11, 17, 3, 25, 31, 35, 41, 8, 22, 43, -13, -17, 17, 5, 11, 12}},
+      {{-114, -14, 0, 9, -20, -7, 42, 59, 19, -17, 9, 23, 18, 46, 30, 30, 29, 46, -18, -11, 6, -5, 17, -4}},
+      {{22, 25, 43, -15, 4, 13, -83, -56, -49, 6, -37, 9, 31, -29, -63, 6, 2, 17, -13, 20, 8, 22, -8, -16}},
+      {{49, 6, 21, -9, 46, -28, 17, -39, 38, 10, 10, 18, 3, -23, -2, 4, -6, 9, 13, 17, 6, -4, 8, -22}},
+      {{-27, -19, -35, -29, -1, 61, -38, -45, -8, -3, -8, 5, 46, -5, 49, -127, -16, -16, -25, 32, 9, 17, -5, 36}},
+      {{82, 110, -30, 9, -11, 1, 12, -7, 30, -25, 33, -19, -29, -16, 30, -31, -12, -36, 33, 22, -8, 15, -3, -6}},
+      {{20, -21, -7, -13, -12, 64, 18, 72, 2, -37, 0, 30, 0, 31, 51, -23, -21, 21, -12, -17, -3, 16, 14, 23}},
+      {{46, 33, 41, 14, -7, 76, 57, 65, -4, -29, -2, 16, -4, 42, -45, 2, 8, 24, 14, 15, -13, -22, 38, -53}},
+      {{-28, -16, 11, -11, 2, 58, 105, -32, 16, -24, 41, -23, 20, -24, 31, 22, 37, -14, 15, -65, -5, -16, 13, 29}},
+      {{28, -47, -23, 63, 8, 17, -118, 18, -48, 0, -43, -102, -1, 34, -53, 10, -25, -45, 17, -5, 10, -17, -3, -25}},
+      {{-12, 2, -1, 82, 7, -35, -6, 3, -40, 39, -27, -51, 13, 15, -5, 61, 19, -10, 1, 13, 2, -54, 6, -33}},
+      {{-11, -24, 35, -29, -1, -3, 66, -64, 42, -24, 43, 10, -50, -54, 36, 11, 29, -27, -10, -35, -8, -19, -7, 48}},
+      {{-50, 68, -11, -18, 3, 8, -84, 5, -49, 1, -44, -56, -12, 13, -6, 9, -19, -13, 15, -8, 25, 28, 1, -36}},
+      {{55, 84, -5, -12, 28, -8, -45, 14, 0, -58, -8, -94, -14, 20, -4, -4, -5, -70, 19, 6, 1, -52, -16, -40}},
+      {{38, 17, 55, -38, 2, -9, -38, -84, -35, 25, -52, 26, 10, -55, -94, 34, 23, -17, -1, 39, 6, 10, -11, -3}}}},
+    // hidden_bias
+    {{756, 776, 550, 2070, -432, 2311, 1250, 100, 606, -601, 3560, 2376, 1179, 2717, 3392, 1215}},
+    // hidden_multiplier
+    1151472493,
+    // hidden_shift
+    38,
+    // output_weights
+    {{
+      {{-26, 42, 28, 17, -18, 42, 6, 29, -54, -63, 122, 51, -46, 64, 40, 0}},
+      {{51, -109, -98, 38, 14, -8, -77, -62, 33, 40, -78, -79, 25, -41, -90, 45}},
+      {{-60, -19, 33, -67, 32, -8, 21, -14, -16, 25, -24, 0, 17, -38, 10, -61}},
+      {{-10, 57, 59, -45, -48, -127, -26, 48, 38, -21, -87, -23, -37, -60, -61, -46}}}},
+    // output_bias
+    {{119, 56, -137, -11}},
+    // margin
+    688};
+
+} // namespace mvmt
+
+#endif
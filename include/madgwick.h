@@ -0,0 +1,119 @@
+#ifndef MVMT_MADGWICK_HPP
+#define MVMT_MADGWICK_HPP
+
+#include <ArduinoEigen/Eigen/Dense>
+#include <ArduinoEigen/Eigen/Geometry>
+#include <cmath>
+
+namespace mvmt {
+
+/// @brief Implements Madgwick's gradient-descent orientation filter, after Madgwick, "An efficient orientation filter
+/// for inertial and inertial/magnetic sensor arrays" (2010). The gyroscope is integrated every sample, and each step is
+/// nudged down the gradient of the error between the measured and predicted directions of gravity and, when available,
+/// the Earth's magnetic field. The orientation maps body coordinates to a world frame whose z axis points up and whose
+/// x axis points towards magnetic north.
+/// @tparam Scalar The floating-point type to run the filter in
+template <typename Scalar> class MadgwickFilter {
+public:
+  using vector_t = Eigen::Matrix<Scalar, 3, 1>;
+  using quaternion_t = Eigen::Quaternion<Scalar>;
+
+  quaternion_t m_orientation;
+  bool m_primed; // Whether the orientation has been seeded from a measurement
+  Scalar m_gain; // Rate at which the gradient corrects the orientation (beta in the paper), in rad/s
+
+public:
+  /// @brief Constructs a MadgwickFilter object.
+  /// @param gain The rate at which measurement errors are corrected, in rad/s. Higher gains converge faster and drift
+  /// less but let more accelerometer and magnetometer noise through.
+  explicit MadgwickFilter(Scalar gain) noexcept
+      : m_orientation(quaternion_t::Identity()), m_primed(false), m_gain(gain) {}
+
+  /// @brief Fuse a nine-axis sample into the orientation estimate.
+  /// @param gyro The angular rate in rad/s, in body coordinates
+  /// @param accel The specific force (pointing up when still) in any unit, in body coordinates
+  /// @param mag The magnetic field in any unit, in body coordinates; a zero vector falls back to a six-axis update
+  /// @param time_delta The time since the previous sample in seconds
+  void update(const vector_t &gyro, const vector_t &accel, const vector_t &mag, Scalar time_delta) noexcept {
+    bool has_accel = !accel.isZero();
+    bool has_mag = has_accel && !mag.isZero();
+    // Seed the orientation from the first usable sample, rather than slowly descending from an arbitrary start
+    if (!m_primed && has_accel) {
+      m_orientation = has_mag ? orientation_from(accel, mag) : quaternion_t::FromTwoVectors(accel, vector_t::UnitZ());
+      m_primed = true;
+      return;
+    }
+
+    const Scalar w = m_orientation.w(), x = m_orientation.x(), y = m_orientation.y(), z = m_orientation.z();
+    // Rate of change of orientation measured by the gyroscope, q' = q * (0, omega) / 2
+    Eigen::Matrix<Scalar, 4, 1> rate;
+    rate << -x * gyro.x() - y * gyro.y() - z * gyro.z(), w * gyro.x() + y * gyro.z() - z * gyro.y(),
+        w * gyro.y() - x * gyro.z() + z * gyro.x(), w * gyro.z() + x * gyro.y() - y * gyro.x();
+    rate *= Scalar(0.5);
+
+    if (has_accel) {
+      vector_t a = accel.normalized();
+      // Error between gravity as the orientation predicts it and as measured, and the Jacobian of that error with
+      // respect to (w, x, y, z)
+      Eigen::Matrix<Scalar, 6, 1> error;
+      Eigen::Matrix<Scalar, 6, 4> jacobian;
+      error.template head<3>() << 2 * (x * z - w * y) - a.x(), 2 * (w * x + y * z) - a.y(),
+          1 - 2 * (x * x + y * y) - a.z();
+      jacobian.template topRows<3>() << -2 * y, 2 * z, -2 * w, 2 * x, //
+          2 * x, 2 * w, 2 * z, 2 * y,                                 //
+          0, -4 * x, -4 * y, 0;
+      int rows = 3;
+      if (has_mag) {
+        vector_t m = mag.normalized();
+        // Take the reference field as the measured field with its heading discarded, so the magnetometer can only
+        // correct yaw and a local disturbance can't tilt the estimate
+        vector_t h = m_orientation * m;
+        Scalar bx = std::sqrt(h.x() * h.x() + h.y() * h.y());
+        Scalar bz = h.z();
+        error.template tail<3>() << bx * (1 - 2 * (y * y + z * z)) + 2 * bz * (x * z - w * y) - m.x(),
+            2 * bx * (x * y - w * z) + 2 * bz * (w * x + y * z) - m.y(),
+            2 * bx * (w * y + x * z) + bz * (1 - 2 * (x * x + y * y)) - m.z();
+        jacobian.template bottomRows<3>() << -2 * bz * y, 2 * bz * z, -4 * bx * y - 2 * bz * w,
+            -4 * bx * z + 2 * bz * x,                                                                     //
+            -2 * bx * z + 2 * bz * x, 2 * bx * y + 2 * bz * w, 2 * bx * x + 2 * bz * z, -2 * bx * w + 2 * bz * y, //
+            2 * bx * y, 2 * bx * z - 4 * bz * x, 2 * bx * w - 4 * bz * y, 2 * bx * x;
+        rows = 6;
+      }
+      Eigen::Matrix<Scalar, 4, 1> step = jacobian.topRows(rows).transpose() * error.head(rows);
+      Scalar step_norm = step.norm();
+      if (step_norm > 0) {
+        rate -= step * (m_gain / step_norm);
+      }
+    }
+
+    m_orientation.coeffs() += Eigen::Matrix<Scalar, 4, 1>(rate[1], rate[2], rate[3], rate[0]) * time_delta;
+    m_orientation.normalize();
+  }
+
+  /// @brief Fuse a six-axis sample into the orientation estimate. Without a magnetometer, heading is free to drift.
+  /// @param gyro The angular rate in rad/s, in body coordinates
+  /// @param accel The specific force (pointing up when still) in any unit, in body coordinates
+  /// @param time_delta The time since the previous sample in seconds
+  void update(const vector_t &gyro, const vector_t &accel, Scalar time_delta) noexcept {
+    update(gyro, accel, vector_t::Zero(), time_delta);
+  }
+
+  /// @brief Get the current orientation estimate, which maps body coordinates to world coordinates.
+  [[nodiscard]] const quaternion_t &orientation() const noexcept { return m_orientation; }
+
+private:
+  /// @brief Solve for the orientation directly from one accelerometer and magnetometer sample.
+  static quaternion_t orientation_from(const vector_t &accel, const vector_t &mag) noexcept {
+    vector_t up = accel.normalized();
+    vector_t west = up.cross(mag).normalized();
+    vector_t north = west.cross(up);
+    // The rows of the body-to-world rotation are the world axes in body coordinates
+    Eigen::Matrix<Scalar, 3, 3> rotation;
+    rotation << north.transpose(), west.transpose(), up.transpose();
+    return quaternion_t(rotation);
+  }
+};
+
+} // namespace mvmt
+
+#endif
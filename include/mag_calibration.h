@@ -0,0 +1,138 @@
+#ifndef MVMT_MAG_CALIBRATION_HPP
+#define MVMT_MAG_CALIBRATION_HPP
+
+#include <ArduinoEigen/Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+
+namespace mvmt {
+
+/// @brief A magnetometer correction: a hard-iron offset, from magnetized parts that move with the board, followed by a
+/// soft-iron transform, from nearby metal that bends the field. Plain data, so it can be stored as raw bytes.
+struct MagCalibration {
+  Eigen::Vector3f offset;    // Hard-iron offset, subtracted from raw readings first
+  Eigen::Matrix3f transform; // Soft-iron correction, mapping the offset readings onto a sphere
+
+  static MagCalibration identity() noexcept { return {Eigen::Vector3f::Zero(), Eigen::Matrix3f::Identity()}; }
+  /// @brief Correct a raw magnetometer reading.
+  [[nodiscard]] Eigen::Vector3f apply(const Eigen::Vector3f &raw) const noexcept { return transform * (raw - offset); }
+};
+
+/// @brief Fits a magnetometer calibration as readings stream in, so the board calibrates itself during normal use
+/// rather than needing a dedicated figure-eight routine. Each reading updates the normal equations of a least-squares
+/// ellipsoid fit, x'Ax + 2b'x = 1, with older readings exponentially forgotten; the fit is solved every few readings.
+/// Memory is constant and each reading costs a fixed 9x9 rank-one update, plus a 9x9 factorization on solving readings.
+/// The sums are kept in double precision: fourth powers of readings far from the origin cancel each other out, and the
+/// fit degenerates in single precision.
+class MagCalibrator {
+  using params_t = Eigen::Matrix<double, 9, 1>;
+
+public:
+  Eigen::Matrix<double, 9, 9> m_normal; // Weighted sum of phi * phi' over readings, upper triangle only
+  params_t m_rhs;                       // Weighted sum of phi over readings
+  double m_weight;                      // Weighted count of readings, with older readings forgotten
+  const double m_scale;                 // Reciprocal of the expected field strength, keeping the sums near one
+  const double m_forgetting;            // Weight kept by the sums on each new reading
+  const std::size_t m_solve_interval;   // Readings between attempts to solve the fit
+  std::size_t m_since_solve;            // Readings since the last attempt to solve the fit
+  MagCalibration m_calibration;         // The latest fit that passed every sanity check
+
+public:
+  /// @brief Constructs a MagCalibrator object.
+  /// @param expected_field The rough strength of the Earth's field, in the magnetometer's unit
+  /// @param memory The number of readings that the fit remembers, roughly
+  /// @param solve_interval The number of readings between attempts to solve the fit
+  MagCalibrator(float expected_field, float memory, std::size_t solve_interval) noexcept
+      : m_normal(Eigen::Matrix<double, 9, 9>::Zero()), m_rhs(params_t::Zero()), m_weight(0),
+        m_scale(1.0 / expected_field), m_forgetting(1.0 - 1.0 / memory), m_solve_interval(solve_interval),
+        m_since_solve(0), m_calibration(MagCalibration::identity()) {}
+
+  /// @brief Add a raw magnetometer reading to the fit.
+  /// @return Whether the reading produced a new calibration
+  bool add_measurement(const Eigen::Vector3f &raw) noexcept {
+    Eigen::Vector3d m = raw.cast<double>() * m_scale;
+    params_t phi;
+    phi << m.x() * m.x(), m.y() * m.y(), m.z() * m.z(), 2 * m.x() * m.y(), 2 * m.x() * m.z(), 2 * m.y() * m.z(),
+        2 * m.x(), 2 * m.y(), 2 * m.z();
+    m_normal.triangularView<Eigen::Upper>() *= m_forgetting;
+    m_normal.selfadjointView<Eigen::Upper>().rankUpdate(phi);
+    m_rhs = m_rhs * m_forgetting + phi;
+    m_weight = m_weight * m_forgetting + 1;
+    if (++m_since_solve < m_solve_interval) {
+      return false;
+    }
+    m_since_solve = 0;
+    return solve();
+  }
+
+  /// @brief Get the latest accepted calibration, which is the identity until a fit succeeds.
+  [[nodiscard]] const MagCalibration &get_current() const noexcept { return m_calibration; }
+  /// @brief Replace the current calibration, such as with one saved before a reboot. Later fits still replace it.
+  void set_current(const MagCalibration &calibration) noexcept { m_calibration = calibration; }
+
+private:
+  static constexpr double MIN_SPREAD = 0.2;    // Smallest standard deviation of readings along any axis, relative to
+                                               // the expected field - less means too few directions were seen
+  static constexpr double MAX_AXIS_RATIO = 2.0; // Soft iron never squashes the field sphere more than this
+  static constexpr double MAX_RESIDUAL = 0.05;  // Largest RMS error of the fit, relative to the field strength
+  static constexpr double MIN_FIELD = 0.3;      // Range of plausible fitted field strengths, relative to expected
+  static constexpr double MAX_FIELD = 3.0;
+
+  /// @brief Solve the fit, accepting the result only if it describes a plausible ellipsoid.
+  bool solve() noexcept {
+    // Until the sums hold a full memory's worth of readings, a handful of similar readings could dominate them
+    if (m_weight < 0.5 / (1 - m_forgetting)) {
+      return false;
+    }
+    // A fit to readings from too narrow a range of directions, such as while the board lies still or turns about one
+    // axis, is underdetermined. The linear terms of the sums give the readings' mean and covariance.
+    Eigen::Vector3d mean = m_rhs.tail<3>() / (2 * m_weight);
+    Eigen::Matrix3d covariance = m_normal.block<3, 3>(6, 6).selfadjointView<Eigen::Upper>().toDenseMatrix() /
+                                     (4 * m_weight) -
+                                 mean * mean.transpose();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> spread;
+    spread.computeDirect(covariance, Eigen::EigenvaluesOnly);
+    if (!(spread.eigenvalues().minCoeff() > MIN_SPREAD * MIN_SPREAD)) {
+      return false;
+    }
+    auto ldlt = m_normal.selfadjointView<Eigen::Upper>().ldlt();
+    if (ldlt.info() != Eigen::Success) {
+      return false;
+    }
+    params_t p = ldlt.solve(m_rhs);
+    Eigen::Matrix3d a;
+    a << p[0], p[3], p[4], //
+        p[3], p[1], p[5],  //
+        p[4], p[5], p[2];
+    Eigen::Vector3d b = p.tail<3>();
+    // Complete the square: (x - c)'A(x - c) = 1 + c'Ac, with the center c = -A^-1 b
+    Eigen::Vector3d center = -a.ldlt().solve(b);
+    double k = 1 + center.dot(a * center);
+    // Mean squared error of the fit, expanded so it can be found from the sums alone. A reading off the ellipsoid by a
+    // fraction e of its radius misses the equation by about 2ke, so dividing by 4k^2 makes the error relative.
+    double residual = (p.dot(m_normal.selfadjointView<Eigen::Upper>() * p) - 2 * p.dot(m_rhs) + m_weight) / m_weight;
+    if (!(residual < 4 * k * k * MAX_RESIDUAL * MAX_RESIDUAL)) {
+      return false;
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen;
+    eigen.computeDirect(a / k);
+    Eigen::Vector3d axes = eigen.eigenvalues();
+    if (!(axes.minCoeff() > 0) || axes.maxCoeff() > MAX_AXIS_RATIO * MAX_AXIS_RATIO * axes.minCoeff()) {
+      return false;
+    }
+    // Scale the transform so a corrected reading keeps the field's fitted strength, the geometric mean radius
+    double radius = 1 / std::cbrt(std::sqrt(axes.prod()));
+    if (radius < MIN_FIELD || radius > MAX_FIELD) {
+      return false;
+    }
+    Eigen::Vector3d root_axes = axes.cwiseSqrt() * radius;
+    m_calibration.offset = (center / m_scale).cast<float>();
+    m_calibration.transform =
+        (eigen.eigenvectors() * root_axes.asDiagonal() * eigen.eigenvectors().transpose()).cast<float>();
+    return true;
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef MVMT_MOTION_PREDICTOR_HPP
+#define MVMT_MOTION_PREDICTOR_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "gauss_filter.h"
+
+namespace mvmt {
+
+/// @brief Implements an alpha-beta tracker, a steady-state constant-velocity Kalman filter, that extrapolates a signal
+/// forward in time. Placed after the smoothing filters, it hides some of the delay that smoothing, the main loop and
+/// the Bluetooth connection add between the hand moving and the cursor following. Prediction overshoots when the
+/// signal suddenly stops, by up to the horizon's worth of its last velocity, so the horizon trades lag for overshoot.
+/// @tparam T The type of the signal, either a floating-point number or an Eigen::Matrix of them
+template <typename T> class AlphaBetaPredictor {
+  using scalar_t = typename scalar_of<T>::type;
+  static_assert(std::is_floating_point<scalar_t>::value, "The alpha-beta predictor requires a floating-point signal");
+
+public:
+  T m_position;       // The tracked value of the signal at the latest sample
+  T m_velocity;       // The tracked rate of change of the signal, per second
+  bool m_primed;      // Whether the tracker has been seeded with a sample
+  scalar_t m_alpha;   // Fraction of each prediction error that corrects the position
+  scalar_t m_beta;    // Fraction of each prediction error, per sample, that corrects the velocity
+  scalar_t m_horizon; // How far ahead of the latest sample get_current() extrapolates, in seconds
+  const scalar_t m_time_delta;
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs an AlphaBetaPredictor object, which extrapolates nothing until given a horizon.
+  /// @param alpha The position gain, between 0 and 1; higher values follow the input more closely
+  /// @param beta The velocity gain, between 0 and 4 - 2 * alpha; higher values react faster to changes in speed but
+  /// pass on more noise
+  /// @param time_delta The difference in time between two samples of the input signal
+  /// @param zero_element The zero point of the input type, typically either 0.0 or a zero Eigen::Matrix
+  AlphaBetaPredictor(double alpha, double beta, double time_delta, T zero_element) noexcept
+      : m_position(zero_element), m_velocity(zero_element), m_primed(false), m_alpha(static_cast<scalar_t>(alpha)),
+        m_beta(static_cast<scalar_t>(beta)), m_horizon(0), m_time_delta(static_cast<scalar_t>(time_delta)),
+        m_zero_element(zero_element) {}
+
+  /// @brief Change how far ahead the output is extrapolated, taking effect immediately.
+  /// @param horizon The time to look ahead, in seconds; zero passes the tracked signal through
+  void set_horizon(double horizon) noexcept { m_horizon = static_cast<scalar_t>(horizon); }
+
+  /// @brief Add a new sample to the tracker's state.
+  /// @param measurement The new sample to add
+  void add_measurement(T measurement) noexcept {
+    // Seed the position with the first sample and assume the signal starts at rest
+    if (!m_primed) {
+      m_position = measurement;
+      m_primed = true;
+      return;
+    }
+    T predicted = m_position + m_velocity * m_time_delta;
+    T error = measurement - predicted;
+    m_position = predicted + m_alpha * error;
+    m_velocity = m_velocity + (m_beta / m_time_delta) * error;
+  }
+  /// @brief Add a batch of consecutive samples to the tracker's state, as if by repeated calls to add_measurement().
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  void add_measurements(const T *measurements, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; i++) {
+      add_measurement(measurements[i]);
+    }
+  }
+  /// @brief Get the tracked signal extrapolated to the horizon.
+  /// @return The predicted value of the signal; if no samples have been added yet, returns the zero element
+  [[nodiscard]] T get_current() const noexcept {
+    return m_primed ? T(m_position + m_velocity * m_horizon) : m_zero_element;
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef MVMT_MOUSE_CURVE_HPP
+#define MVMT_MOUSE_CURVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "fixed_point.h"
+
+namespace mvmt {
+
+/// @brief Map a scaled motion value to a cursor speed, growing exponentially so that small tilts give fine control and
+/// large tilts move quickly. This is the reference the exponential acceleration profile is sampled from.
+/// @tparam T A floating-point type
+template <typename T> T mouse_curve(T value) noexcept {
+  auto sign = std::signbit(value) ? T(-1) : T(1);
+  return sign * (std::exp(std::abs(value)) - T(1));
+}
+
+/// @brief Implements an acceleration profile as a piecewise-linear lookup table, so any curve costs the same handful
+/// of multiplies to evaluate and its shape is data rather than code. Breakpoints are spaced evenly, so the segment an
+/// input falls in is found by scaling rather than searching. The curve is mirrored for negative inputs, and inputs past
+/// the last breakpoint carry on along the last segment.
+/// @tparam T A floating-point type or a Fixed type, matching the motion values the curve is applied to
+/// @tparam Segments The number of linear segments between breakpoints
+template <typename T, std::size_t Segments> class CurveTable {
+  static_assert(Segments > 0, "A curve table needs at least one segment");
+
+public:
+  std::array<T, Segments + 1> m_points; // Output at each breakpoint, from an input of zero up to the table's range
+  T m_inverse_step;                     // Breakpoints per unit of input
+
+public:
+  /// @brief Constructs a CurveTable object from its breakpoints.
+  /// @param points The outputs at evenly spaced inputs from zero up to max_input, starting with the output for zero
+  /// @param max_input The input at the last breakpoint
+  CurveTable(const std::array<double, Segments + 1> &points, double max_input) noexcept
+      : m_inverse_step(static_cast<T>(Segments / max_input)) {
+    for (std::size_t i = 0; i <= Segments; i++) {
+      m_points[i] = static_cast<T>(points[i]);
+    }
+  }
+  /// @brief Build a table by sampling a curve at its breakpoints.
+  /// @param curve A function mapping a non-negative input to an output, as doubles
+  /// @param max_input The input at the last breakpoint
+  template <typename Curve> static CurveTable sample(Curve curve, double max_input) {
+    std::array<double, Segments + 1> points;
+    for (std::size_t i = 0; i <= Segments; i++) {
+      points[i] = curve(max_input * i / Segments);
+    }
+    return CurveTable(points, max_input);
+  }
+
+  /// @brief Look up the curve's output for an input, interpolating between the breakpoints on either side.
+  [[nodiscard]] T evaluate(T value) const noexcept {
+    if constexpr (is_fixed<T>::value) {
+      return evaluate_raw(value);
+    } else {
+      bool negative = value < T();
+      T position = (negative ? -value : value) * m_inverse_step;
+      std::int32_t index = std::min<std::int32_t>(to_int(position), Segments - 1);
+      T fraction = position - from_int<T>(index);
+      T magnitude = m_points[index] + (m_points[index + 1] - m_points[index]) * fraction;
+      return negative ? -magnitude : magnitude;
+    }
+  }
+
+private:
+  /// @brief Look up a fixed-point input on the raw integers, rounding like Fixed's operators but saturating only the
+  /// output, which saves the clamps each Fixed operation would make on the way.
+  [[nodiscard]] T evaluate_raw(T value) const noexcept {
+    using wide_t = decltype(T::ONE);
+    using storage_t = decltype(T::raw);
+    constexpr int BITS = T::FRAC_BITS;
+    constexpr wide_t HALF = T::ONE >> 1;
+    constexpr wide_t MAX = std::numeric_limits<storage_t>::max();
+    wide_t magnitude = value.raw < 0 ? -static_cast<wide_t>(value.raw) : value.raw;
+    // The position saturates like a Fixed product would, which also keeps the product with the segment's rise in range
+    wide_t position = std::min((magnitude * m_inverse_step.raw + HALF) >> BITS, MAX);
+    wide_t index = std::min<wide_t>(position >> BITS, Segments - 1);
+    wide_t fraction = position - (index << BITS);
+    wide_t rise = static_cast<wide_t>(m_points[index + 1].raw) - m_points[index].raw;
+    wide_t result = std::clamp(m_points[index].raw + ((rise * fraction + HALF) >> BITS), -MAX, MAX);
+    return T::from_raw(static_cast<storage_t>(value.raw < 0 ? -result : result));
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef MVMT_NOTCH_FILTER_HPP
+#define MVMT_NOTCH_FILTER_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "gauss_filter.h"
+
+namespace mvmt {
+
+/// @brief The weights of one second-order section, normalized so the leading feedback weight is one.
+/// @tparam Scalar The type of the weights, matching the scalar type of the filtered signal
+template <typename Scalar> struct Biquad {
+  Scalar b0, b1, b2; // Feedforward weights
+  Scalar a1, a2;     // Feedback weights
+
+  /// @brief Design a notch that removes one frequency and passes the rest, after Bristow-Johnson's "Cookbook formulae
+  /// for audio EQ biquad filter coefficients". Gain is exactly one at DC, so a constant signal such as gravity passes
+  /// through untouched.
+  /// @param center The frequency to remove, in Hz
+  /// @param bandwidth The width of the notch between its -3 dB points, in Hz
+  /// @param time_delta The difference in time between two samples of the input signal
+  static Biquad notch(double center, double bandwidth, double time_delta) noexcept {
+    double omega = 2 * M_PI * center * time_delta;
+    double alpha = std::sin(omega) / (2 * center / bandwidth);
+    double a0 = 1 + alpha;
+    double cos_omega = std::cos(omega);
+    return {static_cast<Scalar>(1 / a0), static_cast<Scalar>(-2 * cos_omega / a0), static_cast<Scalar>(1 / a0),
+            static_cast<Scalar>(-2 * cos_omega / a0), static_cast<Scalar>((1 - alpha) / a0)};
+  }
+};
+
+/// @brief Implements a band-stop filter as a cascade of notches spread across a band, aimed at physiological hand
+/// tremor, which sits around 8-12 Hz. Unlike a low-pass, the cascade leaves slower deliberate motion almost untouched,
+/// so a low-pass after it only has to deal with broadband noise and can be much narrower. Each axis costs five
+/// multiplies per stage per sample, and only two values of state per stage are kept.
+/// @tparam T The type of the signal, either a floating-point number or an Eigen::Matrix of them. Each axis of a matrix
+/// is filtered independently.
+/// @tparam Stages The number of notches in the cascade; more stages stop a wider band more deeply
+template <typename T, std::size_t Stages> class NotchFilterBank {
+  using tap_t = typename scalar_of<T>::type;
+  // Narrow notches put the feedback poles close to the unit circle, where fixed-point rounding makes them ring
+  static_assert(std::is_floating_point<tap_t>::value, "The notch filter bank requires a floating-point signal");
+  static_assert(Stages > 0, "The notch filter bank needs at least one stage");
+
+public:
+  std::array<Biquad<tap_t>, Stages> m_sections; // The notches, applied in order
+  std::array<T, Stages> m_s1, m_s2;             // State of each section in transposed direct form II
+  T m_output;                                   // The output of the last section for the latest sample
+  bool m_primed;                                // Whether the filter state has been seeded with a sample
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs a NotchFilterBank object, with its notches centered at even ratios across the band so each one
+  /// covers an equal share of it in octaves.
+  /// @param low_frequency The lower edge of the band to stop, in Hz
+  /// @param high_frequency The upper edge of the band to stop, in Hz
+  /// @param time_delta The difference in time between two samples of the input signal
+  /// @param zero_element The zero point of the input type, typically either 0.0 or a zero Eigen::Matrix
+  NotchFilterBank(double low_frequency, double high_frequency, double time_delta, T zero_element) noexcept
+      : m_output(zero_element), m_primed(false), m_zero_element(zero_element) {
+    m_s1.fill(zero_element);
+    m_s2.fill(zero_element);
+    set_band(low_frequency, high_frequency, time_delta);
+  }
+
+  /// @brief Move the stopped band, such as to suit one user's tremor, keeping the filter state.
+  /// @param low_frequency The lower edge of the band to stop, in Hz
+  /// @param high_frequency The upper edge of the band to stop, in Hz
+  /// @param time_delta The difference in time between two samples of the input signal
+  void set_band(double low_frequency, double high_frequency, double time_delta) noexcept {
+    double step = std::pow(high_frequency / low_frequency, 1.0 / Stages);
+    for (std::size_t i = 0; i < Stages; i++) {
+      double lower = low_frequency * std::pow(step, static_cast<double>(i));
+      double upper = lower * step;
+      // Widening each notch past its share of the band overlaps it with its neighbors, so the stopband has no gaps
+      m_sections[i] = Biquad<tap_t>::notch(std::sqrt(lower * upper), NOTCH_OVERLAP * (upper - lower), time_delta);
+    }
+  }
+
+  /// @brief Add a new sample to the filter's state.
+  /// @param measurement The new sample to add
+  void add_measurement(T measurement) noexcept {
+    // Seed every section at rest with the first sample, so a constant offset like gravity doesn't ring the notches
+    if (!m_primed) {
+      for (std::size_t i = 0; i < Stages; i++) {
+        const Biquad<tap_t> &section = m_sections[i];
+        m_s2[i] = (section.b2 - section.a2) * measurement;
+        m_s1[i] = (section.b1 - section.a1) * measurement + m_s2[i];
+      }
+      m_output = measurement;
+      m_primed = true;
+      return;
+    }
+    T value = measurement;
+    for (std::size_t i = 0; i < Stages; i++) {
+      const Biquad<tap_t> &section = m_sections[i];
+      T next = section.b0 * value + m_s1[i];
+      m_s1[i] = section.b1 * value - section.a1 * next + m_s2[i];
+      m_s2[i] = section.b2 * value - section.a2 * next;
+      value = next;
+    }
+    m_output = value;
+  }
+  /// @brief Add a batch of consecutive samples to the filter's state, as if by repeated calls to add_measurement().
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  void add_measurements(const T *measurements, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; i++) {
+      add_measurement(measurements[i]);
+    }
+  }
+  /// @brief Get the current output of the filter.
+  /// @return The current output value of the filter; if no samples have been added yet, returns the zero element
+  [[nodiscard]] T get_current() const noexcept { return m_primed ? m_output : m_zero_element; }
+
+private:
+  static constexpr double NOTCH_OVERLAP = 2.0; // Width of each notch relative to its share of the band
+};
+
+} // namespace mvmt
+
+#endif
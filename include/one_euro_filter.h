@@ -0,0 +1,94 @@
+#ifndef MVMT_ONE_EURO_FILTER_HPP
+#define MVMT_ONE_EURO_FILTER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "gauss_filter.h"
+
+namespace mvmt {
+
+/// @brief Implements the One Euro filter of Casiez, Roussel and Vogel, "1 Euro Filter: A Simple Speed-based Low-pass
+/// Filter for Noisy Input in Interactive Systems" (2012). A first-order low-pass whose cutoff rises with the speed of
+/// the signal, so it smooths heavily while the signal holds still and barely lags while it moves quickly. Shares its
+/// interface with GaussianFilter so the two can be swapped.
+/// @tparam T The type of the signal, either a floating-point number or an Eigen::Matrix of them. A matrix is filtered
+/// with a single cutoff taken from the speed of the whole vector, so all of its axes lag alike.
+template <typename T> class OneEuroFilter {
+  using scalar_t = typename scalar_of<T>::type;
+  static_assert(std::is_floating_point<scalar_t>::value, "The One Euro filter requires a floating-point signal");
+
+public:
+  T m_value;                   // The current filtered value
+  T m_derivative;              // The filtered rate of change of the signal, per second
+  bool m_primed;               // Whether the filter state has been seeded with a sample
+  scalar_t m_min_cutoff;       // Cutoff frequency in Hz while the signal holds still
+  scalar_t m_beta;             // Increase in cutoff frequency per unit of signal speed
+  scalar_t m_derivative_alpha; // Smoothing weight of the rate of change, which has a fixed cutoff
+  const scalar_t m_time_delta;
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs a OneEuroFilter object.
+  /// @param min_cutoff The cutoff frequency in Hz while the signal holds still; lower values remove more jitter
+  /// @param beta The increase in cutoff frequency per unit of signal speed; higher values lag less when moving
+  /// @param derivative_cutoff The cutoff frequency in Hz used to smooth the estimated speed
+  /// @param time_delta The difference in time between two samples of the input signal
+  /// @param zero_element The zero point of the input type, typically either 0.0 or a zero Eigen::Matrix
+  OneEuroFilter(double min_cutoff, double beta, double derivative_cutoff, double time_delta, T zero_element) noexcept
+      : m_value(zero_element), m_derivative(zero_element), m_primed(false),
+        m_min_cutoff(static_cast<scalar_t>(min_cutoff)), m_beta(static_cast<scalar_t>(beta)),
+        m_derivative_alpha(alpha(static_cast<scalar_t>(derivative_cutoff), static_cast<scalar_t>(time_delta))),
+        m_time_delta(static_cast<scalar_t>(time_delta)), m_zero_element(zero_element) {}
+
+  /// @brief Change how the filter trades jitter for lag, taking effect from the next sample.
+  void set_parameters(double min_cutoff, double beta) noexcept {
+    m_min_cutoff = static_cast<scalar_t>(min_cutoff);
+    m_beta = static_cast<scalar_t>(beta);
+  }
+
+  /// @brief Add a new sample to the filter's state.
+  /// @param measurement The new sample to add
+  void add_measurement(T measurement) noexcept {
+    // Seed the state with the first sample so the output doesn't ramp up from zero
+    if (!m_primed) {
+      m_value = measurement;
+      m_primed = true;
+      return;
+    }
+    T derivative = (measurement - m_value) / m_time_delta;
+    m_derivative = m_derivative + m_derivative_alpha * (derivative - m_derivative);
+    scalar_t cutoff = m_min_cutoff + m_beta * magnitude(m_derivative);
+    m_value = m_value + alpha(cutoff, m_time_delta) * (measurement - m_value);
+  }
+  /// @brief Add a batch of consecutive samples to the filter's state, as if by repeated calls to add_measurement().
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  void add_measurements(const T *measurements, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; i++) {
+      add_measurement(measurements[i]);
+    }
+  }
+  /// @brief Get the current output of the filter.
+  /// @return The current output value of the filter; if no samples have been added yet, returns the zero element
+  [[nodiscard]] T get_current() const noexcept { return m_primed ? m_value : m_zero_element; }
+
+private:
+  /// @brief Get the smoothing weight of a first-order low-pass with the given cutoff frequency.
+  static scalar_t alpha(scalar_t cutoff, scalar_t time_delta) noexcept {
+    scalar_t tau = 1 / (2 * static_cast<scalar_t>(M_PI) * cutoff);
+    return 1 / (1 + tau / time_delta);
+  }
+  static scalar_t magnitude(const T &value) noexcept {
+    if constexpr (std::is_arithmetic<T>::value) {
+      return std::abs(value);
+    } else {
+      return value.norm();
+    }
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef MVMT_ORIENTATION_HPP
+#define MVMT_ORIENTATION_HPP
+
+#include <ArduinoEigen/Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace mvmt {
+
+/// @brief Rebuild a unit quaternion from the vector part reported by the ICM-20948's DMP. The DMP leaves out the scalar
+/// part, since it follows from the other three components of a unit quaternion.
+/// @param x, y, z The vector components of the quaternion, with 30 fractional bits
+template <typename Scalar>
+Eigen::Quaternion<Scalar> quaternion_from_q30(std::int32_t x, std::int32_t y, std::int32_t z) noexcept {
+  constexpr Scalar Q30_ONE = Scalar(1 << 30);
+  Eigen::Matrix<Scalar, 3, 1> vec(x / Q30_ONE, y / Q30_ONE, z / Q30_ONE);
+  // Rounding can push the vector part's length just past one, so clamp rather than take the root of a negative
+  Scalar w = std::sqrt(std::max(Scalar(0), Scalar(1) - vec.squaredNorm()));
+  return Eigen::Quaternion<Scalar>(w, vec.x(), vec.y(), vec.z());
+}
+
+/// @brief Get the rotation that carries one orientation to another, expressed in the body frame of the first.
+/// @return A rotation vector - its direction is the axis of rotation and its length is the angle in radians
+template <typename Scalar>
+Eigen::Matrix<Scalar, 3, 1> rotation_between(const Eigen::Quaternion<Scalar> &from,
+                                             const Eigen::Quaternion<Scalar> &to) noexcept {
+  Eigen::Quaternion<Scalar> delta = from.conjugate() * to;
+  // A quaternion and its negation are the same orientation - pick the one that turns the short way round
+  if (delta.w() < 0) {
+    delta.coeffs() = -delta.coeffs();
+  }
+  Scalar sin_half_angle = delta.vec().norm();
+  if (sin_half_angle < std::numeric_limits<Scalar>::epsilon()) {
+    return 2 * delta.vec();
+  }
+  return delta.vec() * (2 * std::atan2(sin_half_angle, delta.w()) / sin_half_angle);
+}
+
+/// @brief Advance an orientation by a constant angular rate, as a gyroscope reports it.
+/// @param orientation The orientation to advance, mapping body coordinates to world coordinates
+/// @param rate The angular rate in rad/s, in body coordinates
+/// @param time_delta How long the rate was held for, in seconds
+template <typename Scalar>
+Eigen::Quaternion<Scalar> integrate_rate(const Eigen::Quaternion<Scalar> &orientation,
+                                         const Eigen::Matrix<Scalar, 3, 1> &rate, Scalar time_delta) noexcept {
+  Scalar angle = rate.norm() * time_delta;
+  if (angle < std::numeric_limits<Scalar>::epsilon()) {
+    return orientation;
+  }
+  Eigen::AngleAxis<Scalar> step(angle, rate.normalized());
+  return (orientation * Eigen::Quaternion<Scalar>(step)).normalized();
+}
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef MVMT_PIPELINE_HPP
+#define MVMT_PIPELINE_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mvmt {
+
+/// @brief Chains motion processing stages into one, at compile time. A stage is anything with the interface the
+/// filters in this library share: add_measurement(value) takes a sample, and get_current() returns the stage's output
+/// for the latest one. Each sample added to the pipeline is passed through every stage in turn, the output of one
+/// becoming the input of the next. Stages are called directly rather than through virtual functions or
+/// std::function, so a pipeline compiles down to the same code as calling its stages by hand. A pipeline is itself a
+/// stage, so pipelines nest, and any stage can be tested or benchmarked on its own.
+/// The pipeline refers to its stages rather than owning them, since filters may not be copyable and other code may
+/// need to reach them, such as to retune them or to read their state.
+/// @tparam Stages The types of the stages, in the order samples pass through them
+template <typename... Stages> class Pipeline {
+  static_assert(sizeof...(Stages) > 0, "A pipeline needs at least one stage");
+  static constexpr std::size_t LAST = sizeof...(Stages) - 1;
+
+public:
+  std::tuple<Stages &...> m_stages;
+
+public:
+  /// @brief Constructs a Pipeline object from its stages, which must outlive it.
+  explicit Pipeline(Stages &...stages) noexcept : m_stages(stages...) {}
+
+  /// @brief Pass a new sample through every stage.
+  /// @param measurement The new sample, of a type the first stage accepts
+  template <typename T> void add_measurement(const T &measurement) noexcept { feed<0>(measurement); }
+  /// @brief Pass a batch of consecutive samples through every stage, one sample at a time.
+  /// @param measurements The new samples to add, oldest first
+  /// @param count The number of samples to add
+  template <typename T> void add_measurements(const T *measurements, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; i++) {
+      feed<0>(measurements[i]);
+    }
+  }
+  /// @brief Get the output of the last stage.
+  [[nodiscard]] decltype(auto) get_current() const noexcept { return std::get<LAST>(m_stages).get_current(); }
+  /// @brief Get one of the stages, such as to read or retune it.
+  template <std::size_t I> [[nodiscard]] auto &stage() const noexcept { return std::get<I>(m_stages); }
+
+private:
+  template <std::size_t I, typename T> void feed(const T &value) noexcept {
+    auto &stage = std::get<I>(m_stages);
+    stage.add_measurement(value);
+    if constexpr (I < LAST) {
+      feed<I + 1>(stage.get_current());
+    }
+  }
+};
+
+/// @brief Stage that applies a stateless function to each sample, such as a change of units or a response curve.
+/// @tparam In The type of the samples the stage takes
+/// @tparam Function The type of the function, typically a lambda, which is called directly
+template <typename In, typename Function> class MapStage {
+  using out_t = std::decay_t<std::invoke_result_t<const Function &, const In &>>;
+
+public:
+  Function m_function; // Maps each sample to the stage's output
+  out_t m_output;      // The output for the latest sample
+
+public:
+  /// @brief Constructs a MapStage object.
+  /// @param function The function to apply
+  /// @param zero_element The output before any samples have been added
+  MapStage(Function function, out_t zero_element) noexcept : m_function(std::move(function)), m_output(zero_element) {}
+
+  void add_measurement(const In &measurement) noexcept { m_output = m_function(measurement); }
+  [[nodiscard]] const out_t &get_current() const noexcept { return m_output; }
+};
+
+/// @brief Make a MapStage, deducing the type of the function.
+/// @tparam In The type of the samples the stage takes
+template <typename In, typename Function> MapStage<In, Function> map_stage(Function function) noexcept {
+  return MapStage<In, Function>(std::move(function), {});
+}
+
+/// @brief Stage that removes a BiasEstimator's offset from a signal, teaching the estimator each sample on the way.
+/// @tparam Estimator The type of the estimator, such as a BiasEstimator
+/// @tparam T The type of the signal
+template <typename Estimator, typename T> class BiasRemovalStage {
+public:
+  Estimator &m_estimator; // Learns and holds the offset, and may be set from elsewhere, such as by calibration
+  T m_output;             // The latest sample with the offset removed
+
+public:
+  /// @brief Constructs a BiasRemovalStage object.
+  /// @param estimator The estimator to learn the offset with, which must outlive the stage
+  /// @param zero_element The zero point of the signal, typically a zero Eigen::Matrix
+  BiasRemovalStage(Estimator &estimator, T zero_element) noexcept : m_estimator(estimator), m_output(zero_element) {}
+
+  void add_measurement(const T &measurement) noexcept {
+    m_estimator.add_measurement(measurement);
+    m_output = m_estimator.remove(measurement);
+  }
+  [[nodiscard]] const T &get_current() const noexcept { return m_output; }
+};
+
+/// @brief Stage that ignores small values of a signal, such as the tilt left over when the board is put down slightly
+/// off level. The threshold is subtracted from larger values rather than them passing straight through, so the output
+/// grows smoothly from zero at the edge of the deadzone instead of jumping.
+/// @tparam T The type of the signal, either a floating-point number or a Fixed type
+template <typename T> class DeadzoneStage {
+public:
+  T m_threshold; // Largest magnitude that is treated as zero
+  T m_output;    // The output for the latest sample
+
+public:
+  /// @brief Constructs a DeadzoneStage object.
+  /// @param threshold The largest magnitude that is treated as zero
+  explicit DeadzoneStage(T threshold) noexcept : m_threshold(threshold), m_output() {}
+
+  void add_measurement(T measurement) noexcept {
+    if (measurement > m_threshold) {
+      m_output = measurement - m_threshold;
+    } else if (measurement < -m_threshold) {
+      m_output = measurement + m_threshold;
+    } else {
+      m_output = T();
+    }
+  }
+  [[nodiscard]] T get_current() const noexcept { return m_output; }
+};
+
+} // namespace mvmt
+
+#endif
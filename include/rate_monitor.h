@@ -0,0 +1,21 @@
+#ifndef RATE_MONITOR
+#define RATE_MONITOR
+
+#include <Arduino.h>
+
+// Tracks the rate and timing jitter of a periodic event, such as IMU samples arriving
+class RateMonitor {
+  uint32_t lastTimestamp;
+  float meanInterval;     // Exponentially weighted mean time between events, in microseconds
+  float intervalVariance; // Exponentially weighted variance of the time between events, in microseconds squared
+  uint32_t eventCount;
+
+public:
+  RateMonitor();
+  void tick(uint32_t timestamp, uint32_t events = 1);
+  float rate();
+  float jitter();
+  uint32_t count();
+};
+
+#endif
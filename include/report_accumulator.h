@@ -0,0 +1,55 @@
+#ifndef MVMT_REPORT_ACCUMULATOR_HPP
+#define MVMT_REPORT_ACCUMULATOR_HPP
+
+#include <ArduinoEigen/Eigen/Dense>
+#include <cstdint>
+
+namespace mvmt {
+
+/// @brief The movement in one HID mouse report, in counts.
+struct MouseReport {
+  std::int8_t x;
+  std::int8_t y;
+  std::int8_t wheel;
+  std::int8_t h_wheel;
+};
+
+/// @brief Sits between the motion pipeline and HID output, turning fractional movement into whole-count reports. The
+/// fraction of a count that a report can't express is carried over to the next report rather than truncated away, so
+/// slow movement still adds up, and movement beyond what one report can hold is split across several reports.
+class ReportAccumulator {
+public:
+  Eigen::Vector4f m_pending; // Movement not yet reported, in counts: x, y, wheel, horizontal wheel
+  const float m_limit;       // Largest movement held back on any axis, so a flood of motion can't build up a backlog
+
+public:
+  /// The largest movement on one axis of a single report. -128 is also valid, but not mirrored by a positive value.
+  static constexpr std::int8_t REPORT_LIMIT = 127;
+
+  /// @brief Constructs a ReportAccumulator object.
+  /// @param max_reports The most reports any backlog of movement may be split across; extra movement is dropped
+  explicit ReportAccumulator(int max_reports) noexcept
+      : m_pending(Eigen::Vector4f::Zero()), m_limit(static_cast<float>(max_reports) * REPORT_LIMIT) {}
+
+  /// @brief Add movement to be reported.
+  void add(float x, float y, float wheel, float h_wheel) noexcept {
+    m_pending += Eigen::Vector4f(x, y, wheel, h_wheel);
+    m_pending = m_pending.cwiseMax(-m_limit).cwiseMin(m_limit);
+  }
+  /// @brief Check whether at least one whole count of movement is waiting to be reported.
+  [[nodiscard]] bool ready() const noexcept { return (m_pending.cwiseAbs().array() >= 1).any(); }
+  /// @brief Take as many whole counts as fit in one report, leaving the fractions and any excess pending.
+  MouseReport take() noexcept {
+    // Truncating toward zero keeps each remainder the same sign as the movement, so it can't reverse direction
+    Eigen::Vector4f whole = m_pending.cwiseMax(-REPORT_LIMIT).cwiseMin(REPORT_LIMIT).cast<int>().cast<float>();
+    m_pending -= whole;
+    return {static_cast<std::int8_t>(whole[0]), static_cast<std::int8_t>(whole[1]), static_cast<std::int8_t>(whole[2]),
+            static_cast<std::int8_t>(whole[3])};
+  }
+  /// @brief Drop any movement not yet reported.
+  void clear() noexcept { m_pending.setZero(); }
+};
+
+} // namespace mvmt
+
+#endif
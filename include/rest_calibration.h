@@ -0,0 +1,141 @@
+#ifndef MVMT_REST_CALIBRATION_HPP
+#define MVMT_REST_CALIBRATION_HPP
+
+#include <ArduinoEigen/Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace mvmt {
+
+/// @brief Keeps the running mean and variance of each axis of a signal with Welford's method, which stays accurate
+/// over long runs where the naive sum of squares loses its precision to cancellation.
+/// @tparam T The type of the signal, typically an Eigen::Matrix of float
+template <typename T> class RunningStats {
+public:
+  T m_mean;            // Mean of the samples so far
+  T m_sum_squares;     // Sum of squared differences from the mean (M2 in Welford's paper)
+  std::size_t m_count; // Number of samples so far
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs a RunningStats object with no samples.
+  /// @param zero_element The zero point of the signal, typically a zero Eigen::Matrix
+  explicit RunningStats(T zero_element) noexcept
+      : m_mean(zero_element), m_sum_squares(zero_element), m_count(0), m_zero_element(zero_element) {}
+
+  /// @brief Add a new sample to the statistics.
+  void add_measurement(const T &measurement) noexcept {
+    m_count++;
+    T delta = measurement - m_mean;
+    m_mean += delta / static_cast<float>(m_count);
+    m_sum_squares += delta.cwiseProduct(measurement - m_mean);
+  }
+  /// @brief Forget every sample.
+  void clear() noexcept {
+    m_mean = m_zero_element;
+    m_sum_squares = m_zero_element;
+    m_count = 0;
+  }
+  [[nodiscard]] std::size_t count() const noexcept { return m_count; }
+  [[nodiscard]] const T &mean() const noexcept { return m_mean; }
+  /// @brief Get the sample variance of each axis, which is zero until there are two samples.
+  [[nodiscard]] T variance() const noexcept {
+    return m_count > 1 ? T(m_sum_squares / static_cast<float>(m_count - 1)) : m_zero_element;
+  }
+};
+
+/// @brief What the IMU reads while the board rests in the pose the user wants to point from.
+struct RestCalibration {
+  Eigen::Vector3f gravity;   // Mean accelerometer reading, which holds both gravity and the accelerometer's bias
+  Eigen::Vector3f gyro_bias; // Mean gyroscope reading, which should have been zero
+
+  static RestCalibration identity() noexcept { return {Eigen::Vector3f::UnitZ(), Eigen::Vector3f::Zero()}; }
+  /// @brief Get the rotation into a frame levelled at the rest pose: gravity at rest maps onto +z, and the board's x
+  /// axis keeps its heading. A reading in the pose that was calibrated then has no tilt to turn into cursor drift.
+  /// @return The rotation matrix, whose rows are the levelled frame's x, y and z axes in board coordinates
+  [[nodiscard]] Eigen::Matrix3f level_frame() const noexcept {
+    Eigen::Vector3f z = gravity.normalized();
+    Eigen::Vector3f x, y;
+    if (std::abs(z.x()) < 0.9f) {
+      x = (Eigen::Vector3f::UnitX() - z * z.x()).normalized();
+      y = z.cross(x);
+    } else {
+      // Lying on its side, the board's x axis is vertical and has no heading to keep, so keep the y axis's instead
+      y = (Eigen::Vector3f::UnitY() - z * z.y()).normalized();
+      x = y.cross(z);
+    }
+    Eigen::Matrix3f frame;
+    frame << x.transpose(), y.transpose(), z.transpose();
+    return frame;
+  }
+};
+
+/// @brief Measures a RestCalibration on request, from the samples the sensor task already reads, so calibrating never
+/// stalls anything. It collects until the board has been held still for the whole calibration time, starting over
+/// whenever the spread of the samples shows the board moved.
+class RestCalibrator {
+public:
+  RunningStats<Eigen::Vector3f> m_accel; // Statistics of accelerometer readings since collection last started over
+  RunningStats<Eigen::Vector3f> m_gyro;  // Statistics of gyroscope readings since collection last started over
+  const float m_accel_variance;          // Largest variance of any accelerometer axis that counts as still
+  const float m_gyro_variance;           // Largest variance of any gyroscope axis that counts as still
+  const std::size_t m_samples_needed;    // Still samples that make up a calibration
+  bool m_active;                         // Whether a calibration has been requested and not yet finished
+  RestCalibration m_calibration;         // The latest finished calibration
+
+public:
+  /// @brief Constructs a RestCalibrator object, idle until start() is called.
+  /// @param accel_noise The largest standard deviation of accelerometer readings that counts as still
+  /// @param gyro_noise The largest standard deviation of gyroscope readings that counts as still
+  /// @param still_time How long the board must be held still to calibrate, in seconds
+  /// @param time_delta The difference in time between two samples
+  RestCalibrator(float accel_noise, float gyro_noise, float still_time, float time_delta) noexcept
+      : m_accel(Eigen::Vector3f::Zero()), m_gyro(Eigen::Vector3f::Zero()), m_accel_variance(accel_noise * accel_noise),
+        m_gyro_variance(gyro_noise * gyro_noise),
+        m_samples_needed(std::max(MIN_SAMPLES, static_cast<std::size_t>(still_time / time_delta))),
+        m_active(false), m_calibration(RestCalibration::identity()) {}
+
+  /// @brief Begin collecting a new calibration, abandoning any that is under way.
+  void start() noexcept {
+    m_accel.clear();
+    m_gyro.clear();
+    m_active = true;
+  }
+  /// @brief Check whether a calibration is being collected.
+  [[nodiscard]] bool active() const noexcept { return m_active; }
+
+  /// @brief Add a raw sample to the calibration under way, if any.
+  /// @param accel The accelerometer reading, in any unit matching accel_noise
+  /// @param gyro The gyroscope reading, in any unit matching gyro_noise
+  /// @return Whether the sample finished the calibration
+  bool add_measurement(const Eigen::Vector3f &accel, const Eigen::Vector3f &gyro) noexcept {
+    if (!m_active) {
+      return false;
+    }
+    m_accel.add_measurement(accel);
+    m_gyro.add_measurement(gyro);
+    // A handful of samples is too few to judge the spread by, but enough that a real movement shows up soon after
+    if (m_accel.count() >= MIN_SAMPLES &&
+        (m_accel.variance().maxCoeff() > m_accel_variance || m_gyro.variance().maxCoeff() > m_gyro_variance)) {
+      m_accel.clear();
+      m_gyro.clear();
+      return false;
+    }
+    if (m_accel.count() < m_samples_needed) {
+      return false;
+    }
+    m_calibration = {m_accel.mean(), m_gyro.mean()};
+    m_active = false;
+    return true;
+  }
+  /// @brief Get the latest finished calibration, which assumes a level, unbiased IMU until one finishes.
+  [[nodiscard]] const RestCalibration &get_current() const noexcept { return m_calibration; }
+
+private:
+  static constexpr std::size_t MIN_SAMPLES = 8; // Samples collected before the spread is checked
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef MVMT_STILLNESS_DETECTOR_HPP
+#define MVMT_STILLNESS_DETECTOR_HPP
+
+#include <ArduinoEigen/Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+
+namespace mvmt {
+
+/// @brief Decides whether the board is lying still from the spread of raw IMU samples, like the zero-velocity detector
+/// of a foot-mounted inertial navigator. Each axis keeps an exponentially weighted mean and variance, updated in
+/// Welford's incremental form, so a sensor's constant bias or a tilted rest pose never counts as motion; only the
+/// sample-to-sample spread does. A hand holding the board trembles enough to count as moving, so in practice this
+/// detects the board being set down.
+class StillnessDetector {
+public:
+  Eigen::Vector3f m_accel_mean;     // Recent mean of each accelerometer axis
+  Eigen::Vector3f m_accel_variance; // Recent variance of each accelerometer axis
+  Eigen::Vector3f m_gyro_mean;      // Recent mean of each gyroscope axis
+  Eigen::Vector3f m_gyro_variance;  // Recent variance of each gyroscope axis
+  bool m_primed;                    // Whether the means have been seeded with a sample
+  const float m_weight;             // Weight of each new sample in the recent statistics
+  const float m_accel_limit;        // Largest accelerometer variance on any axis that counts as still
+  const float m_gyro_limit;         // Largest gyroscope variance on any axis that counts as still
+  const std::size_t m_still_needed; // Consecutive quiet samples required before the board counts as still
+  std::size_t m_still_count;        // Consecutive quiet samples seen, saturating at m_still_needed
+
+public:
+  /// @brief Constructs a StillnessDetector object, which starts out judging the board to be moving.
+  /// @param accel_noise The largest standard deviation of accelerometer readings that counts as still
+  /// @param gyro_noise The largest standard deviation of gyroscope readings that counts as still
+  /// @param window_time The time constant of the recent statistics, in seconds
+  /// @param still_time How long the spread must stay below the limits before the board counts as still, in seconds
+  /// @param time_delta The difference in time between two samples
+  StillnessDetector(float accel_noise, float gyro_noise, float window_time, float still_time, float time_delta) noexcept
+      : m_accel_mean(Eigen::Vector3f::Zero()), m_accel_variance(Eigen::Vector3f::Zero()),
+        m_gyro_mean(Eigen::Vector3f::Zero()), m_gyro_variance(Eigen::Vector3f::Zero()), m_primed(false),
+        m_weight(std::min(1.0f, time_delta / window_time)), m_accel_limit(accel_noise * accel_noise),
+        m_gyro_limit(gyro_noise * gyro_noise),
+        m_still_needed(std::max<std::size_t>(1, static_cast<std::size_t>(still_time / time_delta))),
+        m_still_count(0) {}
+
+  /// @brief Add a raw sample to the recent statistics.
+  /// @param accel The accelerometer reading, in any unit matching accel_noise
+  /// @param gyro The gyroscope reading, in any unit matching gyro_noise
+  /// @return Whether the board is still after this sample
+  bool add_measurement(const Eigen::Vector3f &accel, const Eigen::Vector3f &gyro) noexcept {
+    // Seed the means with the first sample, or gravity would look like a huge spread until it decayed away
+    if (!m_primed) {
+      m_accel_mean = accel;
+      m_gyro_mean = gyro;
+      m_primed = true;
+      return false;
+    }
+    // The variance takes a while to build up, so a single sample far outside it also ends stillness straight away
+    bool outlier = (accel - m_accel_mean).cwiseAbs2().maxCoeff() > OUTLIER_RATIO * OUTLIER_RATIO * m_accel_limit ||
+                   (gyro - m_gyro_mean).cwiseAbs2().maxCoeff() > OUTLIER_RATIO * OUTLIER_RATIO * m_gyro_limit;
+    update(m_accel_mean, m_accel_variance, accel);
+    update(m_gyro_mean, m_gyro_variance, gyro);
+    bool quiet = !outlier && m_accel_variance.maxCoeff() < m_accel_limit && m_gyro_variance.maxCoeff() < m_gyro_limit;
+    m_still_count = quiet ? std::min(m_still_count + 1, m_still_needed) : 0;
+    return still();
+  }
+  /// @brief Check whether the board has been still for long enough to count as still.
+  [[nodiscard]] bool still() const noexcept { return m_still_count >= m_still_needed; }
+
+private:
+  static constexpr float OUTLIER_RATIO = 3; // Distance from the recent mean, in still standard deviations, of a sample
+                                            // that shows motion on its own
+
+  /// @brief Update an exponentially weighted mean and variance with a new sample, after Finch, "Incremental
+  /// calculation of weighted mean and variance" (2009).
+  void update(Eigen::Vector3f &mean, Eigen::Vector3f &variance, const Eigen::Vector3f &sample) const noexcept {
+    Eigen::Vector3f delta = sample - mean;
+    mean += m_weight * delta;
+    variance = (1 - m_weight) * (variance + m_weight * delta.cwiseProduct(delta));
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef MVMT_TAP_DETECTOR_HPP
+#define MVMT_TAP_DETECTOR_HPP
+
+#include <ArduinoEigen/Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace mvmt {
+
+/// @brief The kinds of tap a TapDetector tells apart.
+enum class Tap : std::uint8_t { NONE, SINGLE, DOUBLE };
+
+/// @brief Detects taps on the board from the raw accelerometer stream, one sample at a time. A tap is a short, sharp
+/// spike away from the slowly moving baseline of gravity and tilt, followed by a moment of quiet: a spike that lasts
+/// too long is deliberate motion rather than a tap, and is ignored. A second tap soon after the first makes a double
+/// tap, so a single tap is only reported once the wait for a second one runs out. Every stage is bounded by a fixed
+/// number of samples, so the time from a tap to its report is bounded too - see latency().
+class TapDetector {
+public:
+  Eigen::Vector3f m_baseline;      // Slowly moving average of the readings, holding gravity and tilt
+  bool m_primed;                   // Whether the baseline has been seeded with a sample
+  const float m_weight;            // Weight of each new sample in the baseline
+  const float m_threshold;         // Squared distance from the baseline that starts a spike
+  const std::size_t m_shock_limit; // Longest spike, in samples, that still counts as a tap
+  const std::size_t m_quiet_limit; // Samples of quiet that must follow a spike before it counts as a tap
+  std::size_t m_double_limit;      // Samples after a tap that a second one makes a double tap; zero for no double taps
+  std::size_t m_timer;             // Samples spent in the current state
+  std::size_t m_onset_age;         // Samples since the latest spike began
+  std::size_t m_pending_age;       // Samples since the spike of a first tap waiting for a second one began
+  std::size_t m_reported_age;      // Samples between the spike of the latest reported tap and its report
+  bool m_pending;                  // Whether a first tap is waiting to find out if a second one follows
+
+private:
+  enum class State : std::uint8_t { IDLE, SHOCK, QUIET, WAIT, REJECT };
+  State m_state;
+
+public:
+  /// @brief Constructs a TapDetector object.
+  /// @param threshold The distance from the baseline, in any unit matching the samples, that a tap must spike past
+  /// @param shock_time The longest time a tap's spike can last, in seconds
+  /// @param quiet_time How long the readings must settle after a spike before it counts as a tap, in seconds
+  /// @param double_time How long after a tap a second one makes a double tap, in seconds; zero reports every tap as a
+  /// single tap, without waiting
+  /// @param baseline_time The time constant of the baseline, in seconds
+  /// @param time_delta The difference in time between two samples
+  TapDetector(float threshold, float shock_time, float quiet_time, float double_time, float baseline_time,
+              float time_delta) noexcept
+      : m_baseline(Eigen::Vector3f::Zero()), m_primed(false), m_weight(std::min(1.0f, time_delta / baseline_time)),
+        m_threshold(threshold * threshold), m_shock_limit(samples(shock_time, time_delta)),
+        m_quiet_limit(samples(quiet_time, time_delta)), m_double_limit(0), m_timer(0), m_onset_age(0),
+        m_pending_age(0), m_reported_age(0), m_pending(false), m_state(State::IDLE) {
+    set_double_time(double_time, time_delta);
+  }
+
+  /// @brief Change how long after a tap a second one makes a double tap, such as to turn double taps on or off.
+  /// @param double_time The time in seconds; zero reports every tap as a single tap, without waiting
+  /// @param time_delta The difference in time between two samples
+  void set_double_time(float double_time, float time_delta) noexcept {
+    m_double_limit = double_time > 0 ? samples(double_time, time_delta) : 0;
+  }
+
+  /// @brief Add a raw sample, and report any tap it completes.
+  /// @param accel The accelerometer reading, in any unit matching threshold
+  /// @return The tap the sample completed, if any
+  Tap add_measurement(const Eigen::Vector3f &accel) noexcept {
+    if (!m_primed) {
+      m_baseline = accel;
+      m_primed = true;
+      return Tap::NONE;
+    }
+    bool spike = (accel - m_baseline).squaredNorm() > m_threshold;
+    m_onset_age++;
+    m_pending_age++;
+    m_timer++;
+    switch (m_state) {
+    case State::IDLE:
+    case State::WAIT:
+      if (spike) {
+        enter(State::SHOCK);
+        m_onset_age = 0;
+        return Tap::NONE;
+      }
+      // The baseline only learns between taps, so a spike never drags it along
+      m_baseline += m_weight * (accel - m_baseline);
+      if (m_state == State::WAIT && m_timer >= m_double_limit) {
+        enter(State::IDLE);
+        return settle_pending();
+      }
+      return Tap::NONE;
+    case State::SHOCK:
+    case State::QUIET:
+      if (spike) {
+        // Ringing after the spike counts as part of it, but the whole spike must stay short
+        if (m_onset_age >= m_shock_limit) {
+          enter(State::REJECT);
+          return settle_pending();
+        }
+        if (m_state == State::QUIET)
+          enter(State::SHOCK);
+        return Tap::NONE;
+      }
+      if (m_state == State::SHOCK)
+        enter(State::QUIET);
+      if (m_timer < m_quiet_limit)
+        return Tap::NONE;
+      if (m_pending) {
+        enter(State::IDLE);
+        m_pending = false;
+        return report(Tap::DOUBLE, m_onset_age);
+      }
+      if (!m_double_limit) {
+        enter(State::IDLE);
+        return report(Tap::SINGLE, m_onset_age);
+      }
+      enter(State::WAIT);
+      m_pending = true;
+      m_pending_age = m_onset_age;
+      return Tap::NONE;
+    case State::REJECT:
+      // Deliberate motion must die down before another tap can start, and the baseline follows it meanwhile
+      m_baseline += m_weight * (accel - m_baseline);
+      if (spike)
+        m_timer = 0;
+      else if (m_timer >= m_quiet_limit)
+        enter(State::IDLE);
+      return Tap::NONE;
+    }
+    return Tap::NONE;
+  }
+  /// @brief Get how many samples before its report the spike of the latest reported tap began.
+  [[nodiscard]] std::size_t reported_age() const noexcept { return m_reported_age; }
+  /// @brief Get the worst-case number of samples from the start of a tap's spike to its report. A single tap waits out
+  /// the double tap window, and possibly a spike within it that turns out to be motion.
+  /// @param kind The kind of tap
+  [[nodiscard]] std::size_t latency(Tap kind) const noexcept {
+    std::size_t confirm = m_shock_limit + m_quiet_limit;
+    return kind == Tap::SINGLE && m_double_limit ? confirm + m_double_limit + m_shock_limit : confirm;
+  }
+
+private:
+  static std::size_t samples(float time, float time_delta) noexcept {
+    return std::max<std::size_t>(1, static_cast<std::size_t>(time / time_delta + 0.5f));
+  }
+  void enter(State state) noexcept {
+    m_state = state;
+    m_timer = 0;
+  }
+  Tap report(Tap kind, std::size_t age) noexcept {
+    m_reported_age = age;
+    return kind;
+  }
+  /// @brief Report a first tap that was waiting for a second one, now that none can follow.
+  Tap settle_pending() noexcept {
+    if (!m_pending)
+      return Tap::NONE;
+    m_pending = false;
+    return report(Tap::SINGLE, m_pending_age);
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef MVMT_THERMAL_BIAS_HPP
+#define MVMT_THERMAL_BIAS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace mvmt {
+
+/// @brief Models how a sensor's bias changes with its die temperature, as a MEMS gyroscope's does while the board
+/// warms up in the hand. The model is a table of biases at evenly spaced temperatures, learned online from readings
+/// taken while the board lies still, and read between learned temperatures by linear interpolation. Once the table
+/// covers the temperatures the board works at, the bias follows the temperature even while the board is moving, when
+/// nothing else can observe it.
+/// As a pipeline stage, it removes the modeled bias at the latest temperature from each sample.
+/// @tparam T The type of the signal, typically an Eigen::Matrix of float
+/// @tparam Bins The number of temperatures in the table
+template <typename T, std::size_t Bins> class ThermalBiasModel {
+  static_assert(Bins > 1, "A thermal bias model needs at least two temperatures");
+
+public:
+  std::array<T, Bins> m_table;       // Bias learned at each temperature
+  std::array<float, Bins> m_weights; // Samples each temperature has learned from, saturating at m_settled_weight
+  const float m_low_temperature;     // Temperature of the first entry, in degrees C
+  const float m_bin_width;           // Temperature between entries, in degrees C
+  const float m_settled_weight;      // Samples after which an entry averages exponentially rather than evenly
+  const float m_learned_weight;      // Samples an entry must have learned from before it is used
+  float m_temperature;               // The latest temperature, in degrees C
+  T m_bias;                          // The modeled bias at the latest temperature
+  T m_output;                        // The latest sample with the modeled bias removed
+  const T m_zero_element;
+
+public:
+  /// @brief Constructs a ThermalBiasModel object, which models no bias until it has learned some.
+  /// @param low_temperature The lowest temperature in the table, in degrees C
+  /// @param high_temperature The highest temperature in the table, in degrees C
+  /// @param learn_time The time constant, in seconds of still samples, over which an entry follows new readings
+  /// @param time_delta The difference in time between two samples of the signal
+  /// @param zero_element The zero point of the signal, typically a zero Eigen::Matrix
+  ThermalBiasModel(float low_temperature, float high_temperature, float learn_time, float time_delta,
+                   T zero_element) noexcept
+      : m_low_temperature(low_temperature), m_bin_width((high_temperature - low_temperature) / (Bins - 1)),
+        m_settled_weight(std::max(1.0f, learn_time / time_delta)),
+        m_learned_weight(std::max(1.0f, LEARNED_SHARE * learn_time / time_delta)), m_temperature(low_temperature),
+        m_bias(zero_element), m_output(zero_element), m_zero_element(zero_element) {
+    m_table.fill(zero_element);
+    m_weights.fill(0);
+  }
+
+  /// @brief Move the model to a new temperature, which changes the bias removed from later samples.
+  /// @param temperature The sensor's die temperature, in degrees C
+  void set_temperature(float temperature) noexcept {
+    m_temperature = temperature;
+    m_bias = bias(temperature);
+  }
+  /// @brief Learn from a reading taken at the latest temperature while the signal should have read zero. The reading
+  /// is shared between the two entries either side of the temperature, in proportion to how close each one is.
+  /// @param measurement The raw reading, bias included
+  void learn(const T &measurement) noexcept {
+    float position = std::clamp((m_temperature - m_low_temperature) / m_bin_width, 0.0f, float(Bins - 1));
+    std::size_t lower = std::min(static_cast<std::size_t>(position), Bins - 2);
+    float upper_share = position - lower;
+    learn_entry(lower, measurement, 1 - upper_share);
+    learn_entry(lower + 1, measurement, upper_share);
+    m_bias = bias(m_temperature);
+  }
+  /// @brief Get the modeled bias at a temperature, interpolating between the nearest learned entries either side and
+  /// holding the nearest one's bias beyond them.
+  /// @param temperature The temperature, in degrees C
+  /// @return The modeled bias; if no entry has been learned yet, returns the zero element
+  [[nodiscard]] T bias(float temperature) const noexcept {
+    float position = (temperature - m_low_temperature) / m_bin_width;
+    // Entries are few, so the nearest learned one on each side is found by walking outwards
+    std::ptrdiff_t below = std::min<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(position), Bins - 1);
+    while (below >= 0 && !learned(below))
+      below--;
+    std::size_t above = static_cast<std::size_t>(std::max(0.0f, position + 1));
+    while (above < Bins && !learned(above))
+      above++;
+    if (below < 0)
+      return above < Bins ? m_table[above] : m_zero_element;
+    if (above >= Bins || position <= below)
+      return m_table[below];
+    float share = (position - below) / (above - below);
+    return T(m_table[below] + (m_table[above] - m_table[below]) * share);
+  }
+  /// @brief Get the modeled bias at the latest temperature.
+  [[nodiscard]] const T &bias() const noexcept { return m_bias; }
+
+  /// @brief Remove the modeled bias at the latest temperature from a new sample.
+  void add_measurement(const T &measurement) noexcept { m_output = measurement - m_bias; }
+  [[nodiscard]] const T &get_current() const noexcept { return m_output; }
+
+private:
+  static constexpr float LEARNED_SHARE = 0.1; // Share of the learn time an entry needs before it is used
+
+  [[nodiscard]] bool learned(std::size_t index) const noexcept { return m_weights[index] >= m_learned_weight; }
+  void learn_entry(std::size_t index, const T &measurement, float share) noexcept {
+    if (share <= 0)
+      return;
+    // Average evenly while the entry is new, then exponentially so it can follow the sensor aging
+    m_weights[index] = std::min(m_weights[index] + share, m_settled_weight);
+    m_table[index] += (measurement - m_table[index]) * (share / m_weights[index]);
+  }
+};
+
+} // namespace mvmt
+
+#endif
@@ -6,6 +6,7 @@
 #include <BleMouse.h>
 #include <FS.h>
 #include <LittleFS.h>
+#include <Preferences.h>
 #include <TFT_eSPI.h>
 #include <Wire.h>
 #include <cmath>
@@ -15,11 +16,28 @@
 #include "3ml_cleaner.h"
 #include "3ml_parser.h"
 #include "CustomBLEMouse.h"
+#include "bias_estimator.h"
+#include "decimator.h"
 #include "display.h"
 #include "gauss_filter.h"
+#include "gesture_model.h"
 #include "io.h"
+#include "madgwick.h"
+#include "mag_calibration.h"
+#include "motion_predictor.h"
+#include "mouse_curve.h"
+#include "notch_filter.h"
+#include "one_euro_filter.h"
+#include "orientation.h"
 #include "pages.h"
+#include "pipeline.h"
 #include "power.h"
+#include "rate_monitor.h"
+#include "report_accumulator.h"
+#include "rest_calibration.h"
+#include "stillness_detector.h"
+#include "tap_detector.h"
+#include "thermal_bias.h"
 #include "ulp_main.h"
 
 
@@ -28,6 +46,76 @@
 // Define this if you want to test functionality without an IMU connected
 // #define NO_SENSOR
 // #define DO_FTP
+// Define this to run the accelerometer filter in single precision through esp-dsp
+// #define DSP_FILTER
+// Define this to smooth the accelerometer with a recursive approximation of the bell curve, whose cost per sample
+// doesn't grow with the bell curve's width
+// #define RECURSIVE_FILTER
+// Define one of these to run the motion pipeline in single precision or fixed point rather than double precision
+// #define FLOAT_MOTION
+// #define Q15_MOTION
+// #define Q31_MOTION
+// Define this to read IMU samples from its FIFO in periodic bursts rather than one at a time on each interrupt
+// #define FIFO_ACQUISITION
+// Define this to point with orientations fused on the IMU's DMP rather than tilting - needs -DICM_20948_USE_DMP
+// #define DMP_POINTING
+// Define this to point with orientations fused from all nine IMU axes by a Madgwick filter running on this MCU
+// #define FUSION_POINTING
+// Define this to notch hand tremor out of tilt before smoothing it, so the smoothing can be much shorter and lag less
+// #define TREMOR_FILTER
+// Define one of these to trade the balanced sensor profile for less lag or less work per second. A profile sets the
+// IMU's sample rate, on-chip low-pass filters and range, and sizes the software smoothing to suit them.
+// #define LOW_LATENCY_PROFILE
+// #define LOW_POWER_PROFILE
+// Define this to print every sample gesture recognition sees, to record traces for tools/train_gestures.py to train on
+// #define GESTURE_RECORDING
+
+#if defined(DMP_POINTING) && !defined(ICM_20948_USE_DMP)
+#error "DMP_POINTING needs the ICM-20948 library built with ICM_20948_USE_DMP"
+#endif
+#if defined(DMP_POINTING) && defined(FIFO_ACQUISITION)
+#error "DMP_POINTING and FIFO_ACQUISITION both claim the IMU's FIFO"
+#endif
+#if defined(FUSION_POINTING) && (defined(DMP_POINTING) || defined(FIFO_ACQUISITION))
+#error "FUSION_POINTING reads every sensor on each interrupt, so it can't be combined with DMP or FIFO acquisition"
+#endif
+#if defined(TREMOR_FILTER) && (defined(DMP_POINTING) || defined(FUSION_POINTING) || defined(Q15_MOTION) ||          \
+                               defined(Q31_MOTION))
+#error "TREMOR_FILTER needs floating-point tilt, so it can't be combined with orientation pointing or fixed point"
+#endif
+#if defined(LOW_LATENCY_PROFILE) && defined(LOW_POWER_PROFILE)
+#error "Only one sensor profile can be chosen"
+#endif
+#if defined(DMP_POINTING) && defined(LOW_LATENCY_PROFILE)
+#error "The DMP fuses at up to 225 Hz, so DMP_POINTING can't sample at LOW_LATENCY_PROFILE's 562 Hz"
+#endif
+#if defined(GESTURE_RECORDING) && (defined(NO_SENSOR) || defined(DMP_POINTING))
+#error "GESTURE_RECORDING needs raw IMU samples, which the DMP doesn't expose"
+#endif
+#if defined(DMP_POINTING) || defined(FUSION_POINTING)
+#define ORIENTATION_POINTING // The cursor follows changes in orientation rather than tilt
+#endif
+#if !defined(NO_SENSOR) && !defined(ORIENTATION_POINTING) && !defined(Q15_MOTION) && !defined(Q31_MOTION)
+#define ADAPTIVE_SMOOTHING // Tilt can be smoothed by a One Euro filter instead, which needs floating-point motion
+#define TILT_PREDICTION    // Tilt can be extrapolated to hide latency, which also needs floating-point motion
+#endif
+#if !defined(NO_SENSOR) && !defined(DMP_POINTING)
+#define MOTION_PREDICTION   // Motion can be extrapolated to hide latency, given the gyroscope's rate of turning
+#define REST_CALIBRATION    // Bias and gravity can be measured at rest, given raw samples that the DMP doesn't expose
+#define STILL_DETECTION     // Lying still can be told apart from holding still, given the same raw samples
+#define TAP_DETECTION       // Taps on the board can click, given the same raw samples at the full sample rate
+#define GESTURE_RECOGNITION // Gestures can stand in for the touch pads, given the same raw samples
+#endif
+
+#if defined(DSP_FILTER) && (defined(Q15_MOTION) || defined(Q31_MOTION))
+#error "DSP_FILTER runs the accelerometer filter in single precision, so it can't be combined with fixed point"
+#endif
+#if defined(RECURSIVE_FILTER) && (defined(DSP_FILTER) || defined(Q15_MOTION) || defined(Q31_MOTION))
+#error "RECURSIVE_FILTER replaces the convolution that DSP_FILTER vectorizes, and needs floating-point motion"
+#endif
+#if defined(FLOAT_MOTION) + defined(Q15_MOTION) + defined(Q31_MOTION) > 1
+#error "Only one motion representation can be chosen"
+#endif
 
 #ifdef DO_FTP
 #include <ESP-FTP-Server-Lib.h>
@@ -44,6 +132,13 @@
 #define SCROLL_TOUCH_CHANNEL 4
 #define LOCK_TOUCH_CHANNEL 3
 #define CALIBRATE_TOUCH_CHANNEL 2
+#define IMU_INT_PIN 26
+#define MOTION_WAIT_TIME 5 // Longest time in ms that loop() waits for new motion before checking other events
+#define FIFO_DRAIN_PERIOD 8 // In FIFO acquisition mode, the IMU's FIFO is drained every FIFO_DRAIN_PERIOD ms
+#define FIFO_SAMPLE_BYTES 12 // Each FIFO record is a big-endian accelerometer sample followed by a gyroscope sample
+#define FIFO_BURST_BYTES 120 // Largest single FIFO read - a whole number of samples that fits the I2C driver's buffer
+#define MAX_REPORTS_PER_SAMPLE 4 // Most mouse reports sent for one sample - faster movement is split over later samples
+#define MAG_SAVE_INTERVAL 60000 // Shortest time in ms between saving magnetometer calibrations, to spare the flash
 #define MOUSE_SCROLL_SPEED -0.05
 #define MOUSE_SCROLL_DEADZONE 0.02 
 #define MOUSE_SCROLL_OFFSET_Y -400
@@ -61,13 +156,283 @@ uint16_t BGND_COLOR = TFT_BLACK;                  // Color of background
 // Mouse logic globals
 #ifndef NO_SENSOR
 ICM_20948_I2C icm;
-constexpr double MOUSE_SENSITIVITY = 0.003;
-mvmt::GaussianFilter<Eigen::Vector3d> accel_readings(0.025, 2, 0.004, Eigen::Vector3d(0, 0, 0));
+#if defined(DSP_FILTER)
+using accel_t = Eigen::Vector3f;
+#elif defined(Q15_MOTION)
+using accel_t = Eigen::Matrix<mvmt::Q15, 3, 1>;
+#elif defined(Q31_MOTION)
+using accel_t = Eigen::Matrix<mvmt::Q31, 3, 1>;
+#elif defined(FLOAT_MOTION)
+using accel_t = Eigen::Vector3f;
+#else
+using accel_t = Eigen::Vector3d;
+#endif
+#if defined(LOW_LATENCY_PROFILE)
+// Sample fast behind wide on-chip filters, so little lag builds up before the short software smoothing, and widen the
+// gyroscope's range so quick flicks don't clip
+constexpr const char *SENSOR_PROFILE_NAME = "LOW LATENCY";
+constexpr uint8_t IMU_SAMPLE_RATE_DIVIDER = 1; // The IMU samples at 1125 Hz / (1 + IMU_SAMPLE_RATE_DIVIDER)
+constexpr uint8_t REPORT_DECIMATION = 5;       // Samples per published motion, giving 112.5 Hz
+constexpr ICM_20948_ACCEL_CONFIG_DLPCFG_e ACCEL_LOW_PASS = acc_d111bw4_n136bw;
+constexpr ICM_20948_GYRO_CONFIG_1_DLPCFG_e GYRO_LOW_PASS = gyr_d119bw5_n154bw3;
+constexpr ICM_20948_GYRO_CONFIG_1_FS_SEL_e GYRO_RANGE = dps500;
+constexpr double GYRO_FULL_SCALE = 500;        // Gyroscope range in dps, matching GYRO_RANGE
+constexpr double PROFILE_ACCEL_STDDEV = 0.012; // Width of the accelerometer smoothing bell curve in seconds
+constexpr double PROFILE_GYRO_STDDEV = 0.004;  // Width of the gyroscope smoothing bell curve in seconds
+#elif defined(LOW_POWER_PROFILE)
+// Sample slowly behind narrow on-chip filters that do most of the smoothing, so the MCU handles a fifth as many
+// samples through a handful of software taps and sleeps in between
+constexpr const char *SENSOR_PROFILE_NAME = "LOW POWER";
+constexpr uint8_t IMU_SAMPLE_RATE_DIVIDER = 10;
+constexpr uint8_t REPORT_DECIMATION = 1; // 102 Hz is already close to the report rate
+constexpr ICM_20948_ACCEL_CONFIG_DLPCFG_e ACCEL_LOW_PASS = acc_d11bw5_n17bw;
+constexpr ICM_20948_GYRO_CONFIG_1_DLPCFG_e GYRO_LOW_PASS = gyr_d11bw6_n17bw8;
+constexpr ICM_20948_GYRO_CONFIG_1_FS_SEL_e GYRO_RANGE = dps250;
+constexpr double GYRO_FULL_SCALE = 250;
+constexpr double PROFILE_ACCEL_STDDEV = 0.012;
+constexpr double PROFILE_GYRO_STDDEV = 0.005;
+#else
+// Sample at a moderate rate behind on-chip filters cutting off well below the Nyquist frequency, leaving the rest of
+// the smoothing to software
+constexpr const char *SENSOR_PROFILE_NAME = "BALANCED";
+#ifdef FIFO_ACQUISITION
+constexpr uint8_t IMU_SAMPLE_RATE_DIVIDER = 1;
+constexpr uint8_t REPORT_DECIMATION = 5;
+#else
+constexpr uint8_t IMU_SAMPLE_RATE_DIVIDER = 4;
+constexpr uint8_t REPORT_DECIMATION = 2;
+#endif
+constexpr ICM_20948_ACCEL_CONFIG_DLPCFG_e ACCEL_LOW_PASS = acc_d50bw4_n68bw8;
+constexpr ICM_20948_GYRO_CONFIG_1_DLPCFG_e GYRO_LOW_PASS = gyr_d51bw2_n73bw3;
+constexpr ICM_20948_GYRO_CONFIG_1_FS_SEL_e GYRO_RANGE = dps250;
+constexpr double GYRO_FULL_SCALE = 250;
+constexpr double PROFILE_ACCEL_STDDEV = 0.025;
+constexpr double PROFILE_GYRO_STDDEV = 0.008;
+#endif
+constexpr double IMU_TIME_DELTA = (1 + IMU_SAMPLE_RATE_DIVIDER) / 1125.0; // Time between IMU samples in seconds
+// If no IMU interrupt arrives within this many ms, about two sample periods, poll the IMU in case an edge was missed
+constexpr uint32_t IMU_INT_TIMEOUT = 1 + static_cast<uint32_t>(2000 * IMU_TIME_DELTA);
+// Motion is published for loop() to report every REPORT_DECIMATION samples, at close to the 7.5-15 ms connection
+// intervals hosts grant BLE mice, since reports any faster would only queue up behind the radio
+constexpr double REPORT_TIME_DELTA = IMU_TIME_DELTA * REPORT_DECIMATION; // Time between published motions in seconds
+// Tilt only ever measures gravity, so every profile keeps the accelerometer at its finest range
+constexpr ICM_20948_ACCEL_CONFIG_FS_SEL_e ACCEL_RANGE = gpm2;
+constexpr double ACCEL_FULL_SCALE = 2000; // Accelerometer range in mg, matching ACCEL_RANGE
+#ifdef TREMOR_FILTER
+// Physiological hand tremor is notched out of tilt first, so the bell curve only has to remove noise and can be short
+constexpr double TREMOR_LOW_FREQUENCY = 8;  // Band of tremor removed from tilt, in Hz
+constexpr double TREMOR_HIGH_FREQUENCY = 12;
+constexpr std::size_t TREMOR_STAGES = 2;    // Notches spread across the tremor band
+// Width of the accelerometer smoothing bell curve in seconds, never wider than the profile's own
+constexpr double ACCEL_STDDEV = std::min(0.008, PROFILE_ACCEL_STDDEV);
+#else
+constexpr double ACCEL_STDDEV = PROFILE_ACCEL_STDDEV; // Width of the accelerometer smoothing bell curve in seconds
+#endif
+constexpr double ACCEL_Z_CUTOFF = 2;      // Standard deviations of lag behind the accelerometer signal
+// Smoothing weights for the accelerometer, computed at compile time and stored in flash
+constexpr auto ACCEL_KERNEL =
+    mvmt::gauss_kernel<accel_t::Scalar, mvmt::gauss_table_length(ACCEL_STDDEV, ACCEL_Z_CUTOFF, IMU_TIME_DELTA)>(
+        ACCEL_STDDEV, ACCEL_Z_CUTOFF, IMU_TIME_DELTA);
+#if defined(ORIENTATION_POINTING)
+// Orientations come from sensor fusion, which does its own smoothing, so accelerations aren't filtered separately
+#elif defined(DSP_FILTER)
+mvmt::GaussianFilter<accel_t, mvmt::DspImpulse> accel_readings(ACCEL_KERNEL, accel_t::Zero());
+#elif defined(RECURSIVE_FILTER)
+mvmt::GaussianFilter<accel_t, mvmt::RecursiveImpulse> accel_readings(ACCEL_STDDEV, ACCEL_Z_CUTOFF, IMU_TIME_DELTA,
+                                                                     accel_t::Zero());
+#else
+mvmt::GaussianFilter<accel_t> accel_readings(ACCEL_KERNEL, accel_t::Zero());
+#endif
+#ifdef TREMOR_FILTER
+mvmt::NotchFilterBank<accel_t, TREMOR_STAGES> accel_tremor(TREMOR_LOW_FREQUENCY, TREMOR_HIGH_FREQUENCY, IMU_TIME_DELTA,
+                                                           accel_t::Zero());
 #endif
+#ifdef ADAPTIVE_SMOOTHING
+// Alternative smoothing that follows fast tilts more closely than the Gaussian filter, chosen from the settings menu
+constexpr double ONE_EURO_MIN_CUTOFF = 1.0;   // Cutoff frequency in Hz while the board is held still
+constexpr double ONE_EURO_BETA = 0.005;       // Increase in cutoff frequency in Hz per mg/s of tilting speed
+constexpr double ONE_EURO_SPEED_CUTOFF = 1.0; // Cutoff frequency in Hz for smoothing the tilting speed itself
+mvmt::OneEuroFilter<accel_t> accel_adaptive(ONE_EURO_MIN_CUTOFF, ONE_EURO_BETA, ONE_EURO_SPEED_CUTOFF, IMU_TIME_DELTA,
+                                            accel_t::Zero());
+#endif
+#ifdef TILT_PREDICTION
+// Smoothed tilt is tracked once per published motion and extrapolated forward to hide the pipeline's latency
+constexpr double PREDICTION_TIME_DELTA = REPORT_TIME_DELTA;
+constexpr double PREDICTION_ALPHA = 0.7; // Share of each tracking error that corrects the tracked tilt
+constexpr double PREDICTION_BETA = 0.3;  // Share of each tracking error that corrects the tracked tilting speed
+mvmt::AlphaBetaPredictor<accel_t> accel_predictor(PREDICTION_ALPHA, PREDICTION_BETA, PREDICTION_TIME_DELTA,
+                                                  accel_t::Zero());
+#endif
+#if defined(Q15_MOTION) || defined(Q31_MOTION)
+// Fixed-point accelerations are fractions of the 2000 mg full scale, so the sensitivity absorbs the full scale and the
+// curve runs in Q16 to leave room for its output
+using curve_t = mvmt::Q16;
+const curve_t MOUSE_SENSITIVITY(0.003 * ACCEL_FULL_SCALE);
+#else
+using curve_t = accel_t::Scalar;
+constexpr curve_t MOUSE_SENSITIVITY = 0.003;
+#endif
+// Acceleration profiles map scaled tilt to a cursor speed in counts per 225th of a second, the rate they were tuned at,
+// and are cycled from the settings menu
+constexpr std::size_t CURVE_SEGMENTS = 64;               // Linear segments in each profile's lookup table
+constexpr double CURVE_RANGE = 0.003 * ACCEL_FULL_SCALE; // Scaled tilt at the accelerometer's full scale
+// The user-defined profile: cursor speeds at evenly spaced tilts from level up to full scale - edit to taste
+constexpr std::array<double, 9> CUSTOM_CURVE = {0, 0.5, 2, 5, 10, 18, 30, 45, 60};
+const mvmt::CurveTable<curve_t, CURVE_SEGMENTS> CURVE_PROFILES[] = {
+    // Exponential, as mouse_curve() computes it: fine control for small tilts and fast motion for large ones
+    mvmt::CurveTable<curve_t, CURVE_SEGMENTS>::sample([](double x) { return mvmt::mouse_curve(x); }, CURVE_RANGE),
+    // Linear, matching the exponential profile at a tilt of about 40 degrees
+    mvmt::CurveTable<curve_t, CURVE_SEGMENTS>::sample([](double x) { return x * (std::exp(2.0) - 1) / 2; },
+                                                      CURVE_RANGE),
+    // Sigmoid, slow around level for precision and leveling off at a top speed for large tilts
+    mvmt::CurveTable<curve_t, CURVE_SEGMENTS>::sample(
+        [](double x) { return 40 / (1 + std::exp(-1.5 * (x - 3))) - 40 / (1 + std::exp(4.5)); }, CURVE_RANGE),
+    mvmt::CurveTable<curve_t, CURVE_SEGMENTS>::sample(
+        [](double x) {
+          double position = x / CURVE_RANGE * (CUSTOM_CURVE.size() - 1);
+          std::size_t index = std::min<std::size_t>(position, CUSTOM_CURVE.size() - 2);
+          return CUSTOM_CURVE[index] + (CUSTOM_CURVE[index + 1] - CUSTOM_CURVE[index]) * (position - index);
+        },
+        CURVE_RANGE),
+};
+const char *const CURVE_NAMES[] = {"EXPONENTIAL", "LINEAR", "SIGMOID", "CUSTOM"};
+uint8_t curveProfile = 0; // Index of the acceleration profile in use
+constexpr float CURVE_SPEED_SCALE = 225 * REPORT_TIME_DELTA; // Converts profile speeds to counts per published motion
+// Tilt becomes cursor speed by scaling, a deadzone around level, and then the acceleration profile in use
+constexpr double CURSOR_DEADZONE = 0.015; // Scaled tilt that doesn't move the cursor, about 5 mg
+auto cursorScale =
+    mvmt::map_stage<accel_t::Scalar>([](accel_t::Scalar value) { return curve_t(value) * MOUSE_SENSITIVITY; });
+mvmt::DeadzoneStage<curve_t> cursorDeadzone{curve_t(CURSOR_DEADZONE)};
+auto cursorProfile = mvmt::map_stage<curve_t>(
+    [](curve_t value) { return static_cast<float>(CURVE_PROFILES[curveProfile].evaluate(value)) * CURVE_SPEED_SCALE; });
+mvmt::Pipeline cursorPipeline(cursorScale, cursorDeadzone, cursorProfile);
+
+#ifndef ORIENTATION_POINTING
+// Turning the board is tracked by integrating the gyroscope, which needs only a short filter once its bias is removed
+constexpr double GYRO_STDDEV = PROFILE_GYRO_STDDEV; // Width of the gyroscope smoothing bell curve in seconds
+constexpr double GYRO_Z_CUTOFF = 2;                 // Standard deviations of lag behind the gyroscope signal
+constexpr auto GYRO_KERNEL =
+    mvmt::gauss_kernel<float, mvmt::gauss_table_length(GYRO_STDDEV, GYRO_Z_CUTOFF, IMU_TIME_DELTA)>(
+        GYRO_STDDEV, GYRO_Z_CUTOFF, IMU_TIME_DELTA);
+constexpr float GYRO_STILL_THRESHOLD = 0.035;  // Angular rate noise in rad/s (about 2 dps) that still counts as still
+constexpr float GYRO_MAX_BIAS = 0.2;           // Largest zero-rate offset in rad/s, past the ICM's 5 dps on every axis
+constexpr float GYRO_STILL_TIME = 0.25;        // Seconds the board must be held still before the bias learns
+constexpr float GYRO_BIAS_TIME_CONSTANT = 2.0; // Seconds for the learned bias to follow slow drift
+mvmt::GaussianFilter<Eigen::Vector3f> gyro_readings(GYRO_KERNEL, Eigen::Vector3f::Zero());
+mvmt::BiasEstimator<Eigen::Vector3f> gyroBias(GYRO_STILL_THRESHOLD, GYRO_MAX_BIAS, GYRO_STILL_TIME,
+                                              GYRO_BIAS_TIME_CONSTANT, IMU_TIME_DELTA, Eigen::Vector3f::Zero());
+// The bias also drifts with the die temperature as the board warms in the hand. A table of the bias at each
+// temperature, learned whenever the board lies still, follows that drift while the board is moving and is removed
+// first, leaving the bias estimator only the slower drift that temperature doesn't explain.
+constexpr float THERMAL_LOW_TEMPERATURE = 10;  // Lowest die temperature in the table, in degrees C
+constexpr float THERMAL_HIGH_TEMPERATURE = 50; // Highest die temperature in the table, in degrees C
+constexpr size_t THERMAL_BINS = 17;            // Temperatures in the table, 2.5 degrees C apart
+constexpr float THERMAL_LEARN_TIME = 10;       // Seconds lying still at a temperature for its bias to settle
+mvmt::ThermalBiasModel<Eigen::Vector3f, THERMAL_BINS> gyroThermalBias(THERMAL_LOW_TEMPERATURE, THERMAL_HIGH_TEMPERATURE,
+                                                                      THERMAL_LEARN_TIME, IMU_TIME_DELTA,
+                                                                      Eigen::Vector3f::Zero());
+mvmt::BiasRemovalStage<decltype(gyroBias), Eigen::Vector3f> gyroDebias(gyroBias, Eigen::Vector3f::Zero());
+mvmt::Pipeline gyroPipeline(gyroThermalBias, gyroDebias, gyro_readings);
+Eigen::Quaternionf gyroOrientation = Eigen::Quaternionf::Identity(); // Integrated by the sensor task
+#endif
+#ifdef FUSION_POINTING
+constexpr float FUSION_GAIN = 0.05; // Rate in rad/s at which the Madgwick filter corrects gyroscope drift
+mvmt::MadgwickFilter<float> fusion(FUSION_GAIN);
+// The magnetometer is calibrated continuously in the background, and each new calibration is saved to NVS
+constexpr float MAG_EXPECTED_FIELD = 50;        // Rough strength of the Earth's magnetic field in uT
+constexpr float MAG_CALIBRATION_MEMORY = 2000;  // Readings the calibration fit remembers - 20 s at 100 Hz
+constexpr size_t MAG_CALIBRATION_INTERVAL = 50; // Readings between attempts to solve the calibration fit
+mvmt::MagCalibrator magCalibrator(MAG_EXPECTED_FIELD, MAG_CALIBRATION_MEMORY, MAG_CALIBRATION_INTERVAL);
+// The sensor task publishes each new calibration here for loop() to save, keeping flash writes out of the sensor task
+xQueueHandle magCalibrationQueue = xQueueCreate(1, sizeof(mvmt::MagCalibration));
+Preferences calibrationStore;
+uint32_t magCalibrationSaveTime = 0;
+#endif
+#ifdef REST_CALIBRATION
+// Pressing the calibrate button measures the IMU at rest in the background, without pausing the cursor
+constexpr float REST_ACCEL_NOISE = 10 * 32768 / ACCEL_FULL_SCALE; // Accelerometer spread in counts (10 mg) at rest
+constexpr float REST_GYRO_NOISE = 0.02;                           // Gyroscope spread in rad/s (about 1 dps) at rest
+constexpr float REST_STILL_TIME = 1.0;                            // Seconds the board must be held still to calibrate
+mvmt::RestCalibrator restCalibrator(REST_ACCEL_NOISE, REST_GYRO_NOISE, REST_STILL_TIME, IMU_TIME_DELTA);
+volatile bool restCalibrationRequested = false; // Set by loop() on a calibrate press, picked up by the sensor task
+Eigen::Matrix3f restFrame = Eigen::Matrix3f::Identity(); // Levels raw accelerometer readings against the rest pose
+#endif
+#ifdef STILL_DETECTION
+// While the board lies still its motion is frozen, so it neither drifts nor spends radio airtime on empty reports
+constexpr float STILL_ACCEL_NOISE = 6 * 32768 / ACCEL_FULL_SCALE; // Accelerometer spread in counts (6 mg) at rest
+constexpr float STILL_GYRO_NOISE = 0.01;                          // Gyroscope spread in rad/s (about 0.6 dps) at rest
+constexpr float STILL_WINDOW_TIME = 0.2;                          // Seconds of samples the spread is judged over
+constexpr float STILL_TIME = 0.5;                                 // Seconds of quiet before the board counts as still
+mvmt::StillnessDetector stillness(STILL_ACCEL_NOISE, STILL_GYRO_NOISE, STILL_WINDOW_TIME, STILL_TIME, IMU_TIME_DELTA);
+#endif
+#ifdef TAP_DETECTION
+// Tapping the board can left click, and double tapping right click, as chosen from the settings menu. A single tap
+// waits out the double tap window before it clicks, so double taps are only recognized when asked for.
+constexpr float TAP_THRESHOLD = 400 * 32768 / ACCEL_FULL_SCALE; // Spike in counts (400 mg) that starts a tap
+constexpr float TAP_SHOCK_TIME = 0.02;                          // Longest spike in seconds that is still a tap
+constexpr float TAP_QUIET_TIME = 0.02;                          // Seconds of quiet that confirm a spike as a tap
+constexpr float TAP_DOUBLE_TIME = 0.2;                          // Seconds after a tap that a second one doubles it
+constexpr float TAP_BASELINE_TIME = 0.1;                        // Time constant in seconds of gravity and tilt
+mvmt::TapDetector tapDetector(TAP_THRESHOLD, TAP_SHOCK_TIME, TAP_QUIET_TIME, 0, TAP_BASELINE_TIME, IMU_TIME_DELTA);
+const char *const TAP_MODE_NAMES[] = {"TAP CLICKS OFF", "TAP TO CLICK", "TAP AND DOUBLE TAP TO CLICK"};
+// Index into TAP_MODE_NAMES of the tap clicks in use; set from the settings menu and picked up by the sensor task
+volatile uint8_t tapMode = 0;
+volatile uint32_t tapTime = 0;         // micros() at the spike of the latest tap the sensor task clicked for
+volatile bool tapClickPending = false; // Set when the sensor task queues a tap's click, cleared when loop() sends it
+uint32_t tapLatencyWorst = 0;          // Longest time in us from a tap to its click in the current tap mode
+#endif
+#ifdef GESTURE_RECOGNITION
+// Flicking the board left can go back, twisting it toggle scrolling and shaking it lock the mouse, as recognized by a
+// small quantized network trained with tools/train_gestures.py on traces recorded with GESTURE_RECORDING
+static_assert(GYRO_FULL_SCALE <= 500, "Gesture features only scale the gyroscope from ranges up to 500 dps");
+constexpr double GESTURE_SAMPLE_RATE = 56.25; // Rate in Hz that gestures are recognized and traces recorded at
+constexpr size_t GESTURE_DECIMATION = size_t(std::max(1.0, 1 / (IMU_TIME_DELTA * GESTURE_SAMPLE_RATE) + 0.5));
+constexpr int GESTURE_GYRO_SHIFT = GYRO_FULL_SCALE > 250 ? 1 : 0; // Scales the gyroscope to read as at 250 dps
+constexpr size_t GESTURE_CONFIRM_WINDOWS = 2;                     // Windows in a row that must agree on a gesture
+constexpr size_t GESTURE_REARM_WINDOWS = 2;                       // Windows of no gesture between two gestures
+constexpr uint32_t GESTURE_CYCLE_BUDGET = 20000;                  // Most CPU cycles (83 us) a window may take
+mvmt::GestureFeatureExtractor gestureFeatures(GESTURE_DECIMATION, GESTURE_GYRO_SHIFT);
+mvmt::GestureNetwork gestureNetwork(mvmt::GESTURE_MODEL);
+mvmt::GestureTrigger gestureTrigger(GESTURE_CONFIRM_WINDOWS, GESTURE_REARM_WINDOWS);
+bool gestureEnableState = false; // Whether recognized gestures act, as chosen from the settings menu
+uint32_t gestureCyclesWorst = 0; // Most CPU cycles a window has taken to recognize since start up
+#endif
+constexpr float POINTING_SENSITIVITY = 1000;      // Cursor counts per radian the board turns
+constexpr float POINTING_SCROLL_SENSITIVITY = 50; // Scroll wheel counts per radian the board turns
+Eigen::Quaternionf lastOrientation;               // Orientation at the last sample loop() picked up
+bool orientationKnown = false;
+// Movement not yet sent to the host, holding fractions of a count and anything too big for one report
+mvmt::ReportAccumulator pendingMotion(2 * MAX_REPORTS_PER_SAMPLE);
+
+// Everything the sensor task knows about the board's motion after a sample
+struct motion_t {
+  accel_t accel;                  // Filtered acceleration, for pointing by tilting
+  Eigen::Quaternionf orientation; // Orientation, for pointing by turning
+  bool still;                     // Whether the board is lying still, so any motion is noise or drift
+};
+// The sensor task publishes motion here at the report rate, overwriting any motion loop() hasn't picked up yet
+xQueueHandle motionQueue = xQueueCreate(1, sizeof(motion_t));
+mvmt::Decimator reportDecimator(REPORT_DECIMATION); // Picks the samples whose motion is published
+#endif
+
+// Achieved IMU sample and motion publishing rates, and sample timing jitter, shown on the debug page
+RateMonitor imuRate;
+// Samples the sensor task only found by polling because their interrupt never came, shown on the debug page
+volatile uint32_t missedInterrupts = 0;
+RateMonitor reportRate;
+// CPU cycles taken by the latest sample's work at the sample rate, such as filtering or sensor fusion, and by the
+// latest published motion's work at the report rate, shown on the debug page
+uint32_t sampleCycles = 0;
+uint32_t reportCycles = 0;
+// Movement reports sent to the host, and samples that sent none because the board was still or moved under a count,
+// shown on the debug page
+uint32_t reportsSent = 0;
+uint32_t reportsSuppressed = 0;
 
 CustomBLEMouse mouse("Mouseless Mouse " __TIME__, "Mouseless Team");
-Eigen::Vector3f calibratedPosX;
-Eigen::Vector3f calibratedPosZ;
+// Axes of the level frame found by the latest rest calibration, in board coordinates
+Eigen::Vector3f calibratedPosX = Eigen::Vector3f::UnitX();
+Eigen::Vector3f calibratedPosZ = Eigen::Vector3f::UnitZ(); // Points up, against gravity, in the calibrated pose
 
 // Create event queues for inter-process/ISR communication
 xQueueHandle navigationEvents = xQueueCreate(4, sizeof(pageEvent_t));
@@ -131,6 +496,22 @@ void modifyHue(byte newHue) {
   SEL_COLOR = ACCENT_COLOR >> 1 & ~0x0410; // Equivalent to lerp(ACCENT_COLOR, TFT_BLACK, 0.5)
 }
 
+// Keep track of which mouse functions are active
+bool mouseEnableState = true;
+bool scrollEnableState = false;
+#ifdef ORIENTATION_POINTING
+bool turnEnableState = true; // Whether the mouse follows the board turning rather than tilting
+#else
+bool turnEnableState = false;
+#endif
+bool adaptiveSmoothingState = false; // Whether tilt is smoothed by the One Euro filter rather than the Gaussian filter
+#ifdef MOTION_PREDICTION
+constexpr float PREDICTION_STEP = 0.004; // Seconds of prediction added by each notch of the prediction slider
+// How far ahead of the latest sample motion is extrapolated, in seconds; set from the settings menu and picked up by
+// the sensor task
+volatile float predictionHorizon = 0;
+#endif
+
 char *dummyField = new char[32];
 
 void swapBoardRotation() {
@@ -144,6 +525,92 @@ void swapBoardRotation() {
   downButton.attach();
 }
 
+#if !defined(NO_SENSOR) && !defined(ORIENTATION_POINTING)
+// Switch between pointing by tilting the board and pointing by turning it
+void swapPointingMode() {
+  turnEnableState = !turnEnableState;
+  Serial.println(turnEnableState ? "POINTING BY TURNING" : "POINTING BY TILTING");
+}
+#endif
+
+#ifdef MOTION_PREDICTION
+void modifyPrediction(byte notches) {
+  predictionHorizon = notches * PREDICTION_STEP;
+}
+#endif
+
+#ifndef NO_SENSOR
+// Switch to the next acceleration profile, wrapping around after the last
+void cycleCurveProfile() {
+  curveProfile = (curveProfile + 1) % (sizeof(CURVE_PROFILES) / sizeof(CURVE_PROFILES[0]));
+  Serial.printf("%s ACCELERATION\n", CURVE_NAMES[curveProfile]);
+}
+#endif
+
+#ifdef TAP_DETECTION
+// Get how long after a tap a second one makes a double tap in a tap mode, in seconds. Recognizing double taps delays
+// single taps, so the detector only waits for a second tap when the mode has a use for one.
+float tapDoubleTime(uint8_t mode) {
+  return mode == 2 ? TAP_DOUBLE_TIME : 0;
+}
+
+// Get the worst-case time in us from a tap's spike to loop() pressing the button for it in a tap mode: the tap
+// detector's own bound, plus the longest a sample takes to reach the sensor task and a queued click takes to reach
+// loop()
+uint32_t tapLatencyBudget(mvmt::Tap kind, uint8_t mode) {
+#ifdef FIFO_ACQUISITION
+  constexpr double ACQUISITION_TIME = FIFO_DRAIN_PERIOD / 1000.0;
+#else
+  constexpr double ACQUISITION_TIME = IMU_TIME_DELTA;
+#endif
+  // The sensor task owns the live detector, so the bound comes from one configured the same way
+  mvmt::TapDetector detector(TAP_THRESHOLD, TAP_SHOCK_TIME, TAP_QUIET_TIME, tapDoubleTime(mode), TAP_BASELINE_TIME,
+                             IMU_TIME_DELTA);
+  return (detector.latency(kind) * IMU_TIME_DELTA + ACQUISITION_TIME + MOTION_WAIT_TIME / 1000.0) * 1e6;
+}
+
+// Switch to the next choice of tap clicks, wrapping around after the last
+void cycleTapMode() {
+  uint8_t mode = (tapMode + 1) % (sizeof(TAP_MODE_NAMES) / sizeof(TAP_MODE_NAMES[0]));
+  tapMode = mode;
+  Serial.printf("%s\n", TAP_MODE_NAMES[mode]);
+  if (mode)
+    Serial.printf("TAP LATENCY BUDGET: %.1f ms\n", tapLatencyBudget(mvmt::Tap::SINGLE, mode) / 1000.0);
+}
+
+// Report how long a tap took to become a button press, against the latency budget
+void reportTapLatency(mouseEvent_t press) {
+  static uint8_t worstMode = 0; // Tap mode the worst latency was measured in
+  uint8_t mode = tapMode;
+  tapClickPending = false;
+  if (mode != worstMode) {
+    worstMode = mode;
+    tapLatencyWorst = 0;
+  }
+  uint32_t latency = micros() - tapTime;
+  tapLatencyWorst = std::max(tapLatencyWorst, latency);
+  mvmt::Tap kind = press == mouseEvent_t::RMB_PRESS ? mvmt::Tap::DOUBLE : mvmt::Tap::SINGLE;
+  Serial.printf("TAP CLICK: %.1f ms (worst %.1f ms, budget %.1f ms)\n", latency / 1000.0, tapLatencyWorst / 1000.0,
+                tapLatencyBudget(kind, mode) / 1000.0);
+}
+#endif
+
+#ifdef GESTURE_RECOGNITION
+// Switch acting on recognized gestures on or off
+void swapGestureState() {
+  gestureEnableState = !gestureEnableState;
+  Serial.println(gestureEnableState ? "GESTURES ENABLED" : "GESTURES DISABLED");
+}
+#endif
+
+#ifdef ADAPTIVE_SMOOTHING
+// Switch between smoothing tilt with the fixed Gaussian filter and the speed-adaptive One Euro filter
+void swapSmoothingMode() {
+  adaptiveSmoothingState = !adaptiveSmoothingState;
+  Serial.println(adaptiveSmoothingState ? "ONE EURO SMOOTHING" : "GAUSSIAN SMOOTHING");
+}
+#endif
+
 #ifdef DO_FTP
 void ftpTask(void *pvParameters) {
   FTPServer *ftp = new FTPServer();
@@ -184,9 +651,51 @@ ConfirmationPage startFTP(&display, &displayManager, "Edit Filesystem");
 // Instantiate display page hierarchy
 InlineSlider themeColorSlider(&display, &displayManager, "Theme Color", modifyHue);
 ConfirmationPage flipDisplay(&display, &displayManager, "Swap Rotation");
+#if !defined(NO_SENSOR) && !defined(ORIENTATION_POINTING)
+ConfirmationPage swapPointing(&display, &displayManager, "Pointing Mode");
+#endif
+#ifndef NO_SENSOR
+ConfirmationPage cycleCurve(&display, &displayManager, "Acceleration");
+#endif
+#ifdef TAP_DETECTION
+ConfirmationPage cycleTaps(&display, &displayManager, "Tap Clicks");
+#endif
+#ifdef GESTURE_RECOGNITION
+ConfirmationPage swapGestures(&display, &displayManager, "Gestures");
+#endif
+#ifdef ADAPTIVE_SMOOTHING
+ConfirmationPage swapSmoothing(&display, &displayManager, "Smoothing");
+#endif
+#ifdef MOTION_PREDICTION
+InlineSlider predictionSlider(&display, &displayManager, "Prediction", modifyPrediction);
+#endif
 
 MenuPage settingsPage(&display, &displayManager, "Settings", &themeColorSlider,
                       flipDisplay("Are you sure?", swapBoardRotation)
+#if !defined(NO_SENSOR) && !defined(ORIENTATION_POINTING)
+                          ,
+                      swapPointing("Tilt <-> turn?", swapPointingMode)
+#endif
+#ifndef NO_SENSOR
+                          ,
+                      cycleCurve("Next profile?", cycleCurveProfile)
+#endif
+#ifdef TAP_DETECTION
+                          ,
+                      cycleTaps("Next mode?", cycleTapMode)
+#endif
+#ifdef GESTURE_RECOGNITION
+                          ,
+                      swapGestures("Off <-> on?", swapGestureState)
+#endif
+#ifdef ADAPTIVE_SMOOTHING
+                          ,
+                      swapSmoothing("Fixed <-> adaptive?", swapSmoothingMode)
+#endif
+#ifdef MOTION_PREDICTION
+                          ,
+                      &predictionSlider
+#endif
 #ifdef DO_FTP
                           ,
                       startFTP("Stop mouse?", hangAndFTP)
@@ -202,10 +711,6 @@ MenuPage mainMenuPage(&display, &displayManager, "Main Menu", &inputViewPage, &t
                       keyboard(dummyField), confirm("Are you sure?", deepSleep));
 HomePage homepage(&display, &displayManager, "Home Page", &mainMenuPage);
 
-// Keep track of which mouse functions are active
-bool mouseEnableState = true;
-bool scrollEnableState = false;
-
 // Use the ADC to read the battery voltage - convert result to a percentage
 int16_t getBatteryPercentage() {
   digitalWrite(ADC_ENABLE_PIN, HIGH);
@@ -266,11 +771,368 @@ void printDom(threeml::DOM dom) {
     recPrintDomNode(node, 0);
 }
 
-double mouseCurve(double value) {
-  auto sign = std::signbit(value) ? -1.0 : 1.0;
-  return sign * (std::exp(std::abs(value)) - 1.0);
+#ifndef NO_SENSOR
+// Convert raw accelerometer counts to the motion pipeline's numeric representation
+accel_t toAccel(int16_t x, int16_t y, int16_t z) {
+#ifdef REST_CALIBRATION
+  // Level the reading against the calibrated rest pose, so holding the board in that pose doesn't drift the cursor
+  Eigen::Vector3f counts = restFrame * Eigen::Vector3f(x, y, z);
+#else
+  Eigen::Vector3f counts(x, y, z);
+#endif
+#if defined(Q15_MOTION) || defined(Q31_MOTION)
+  // Raw readings are already signed fractions of full scale
+  return accel_t(accel_t::Scalar::from_fixed<15>(std::lround(counts.x())),
+                 accel_t::Scalar::from_fixed<15>(std::lround(counts.y())),
+                 accel_t::Scalar::from_fixed<15>(std::lround(counts.z())));
+#else
+  constexpr accel_t::Scalar MG_PER_COUNT = ACCEL_FULL_SCALE / 32768;
+  return counts.cast<accel_t::Scalar>() * MG_PER_COUNT;
+#endif
+}
+
+#ifdef REST_CALIBRATION
+// Feed one raw sample to the rest calibration, starting one if loop() asked for it and applying it once it finishes
+void calibrateRest(const Eigen::Vector3f &accelCounts, const Eigen::Vector3f &rate) {
+  if (restCalibrationRequested) {
+    restCalibrationRequested = false;
+    restCalibrator.start();
+  }
+  if (!restCalibrator.add_measurement(accelCounts, rate))
+    return;
+  const mvmt::RestCalibration &calibration = restCalibrator.get_current();
+  restFrame = calibration.level_frame();
+  calibratedPosX = restFrame.row(0).transpose();
+  calibratedPosZ = restFrame.row(2).transpose();
+#ifndef ORIENTATION_POINTING
+  gyroBias.set_current(calibration.gyro_bias - gyroThermalBias.bias());
+#endif
+  Serial.println("CALIBRATED");
+}
+#endif
+
+#ifdef TAP_DETECTION
+// Queue a button press and its release for loop(), or neither if the queue can't take both, so a button is never left
+// held down
+// @return Whether the click was queued
+bool sendClick(mouseEvent_t press, mouseEvent_t release) {
+  if (uxQueueSpacesAvailable(mouseEvents) < 2)
+    return false;
+  xQueueSend(mouseEvents, &press, 0);
+  xQueueSend(mouseEvents, &release, 0);
+  return true;
+}
+
+// Feed one raw accelerometer sample to the tap detector, queueing a click for loop() when it completes a tap
+// @param age How many samples ago the sample was taken, as it may have waited in the FIFO
+void detectTap(const Eigen::Vector3f &accelCounts, uint32_t age) {
+  static uint8_t appliedMode = 0; // Tap mode the detector is set up for
+  uint8_t mode = tapMode;
+  if (mode != appliedMode) {
+    appliedMode = mode;
+    tapDetector.set_double_time(tapDoubleTime(mode), IMU_TIME_DELTA);
+  }
+  mvmt::Tap tap = tapDetector.add_measurement(accelCounts);
+  if (tap == mvmt::Tap::NONE || !mode)
+    return;
+  // The click is marked before it is queued, so loop() can't pick up its press first
+  tapTime = micros() - uint32_t((tapDetector.reported_age() + age) * IMU_TIME_DELTA * 1e6);
+  tapClickPending = true;
+  bool sent = tap == mvmt::Tap::DOUBLE ? sendClick(mouseEvent_t::RMB_PRESS, mouseEvent_t::RMB_RELEASE)
+                                       : sendClick(mouseEvent_t::LMB_PRESS, mouseEvent_t::LMB_RELEASE);
+  if (!sent)
+    tapClickPending = false;
+}
+#endif
+
+#ifdef GESTURE_RECOGNITION
+// Feed one raw sample to gesture recognition, queueing for loop() the button events a recognized gesture stands for
+// @param raw The raw accelerometer counts, then the raw gyroscope counts
+void recognizeGesture(const mvmt::GestureFeatureExtractor::sample_t &raw) {
+  uint32_t startCycles = ESP.getCycleCount();
+  bool windowReady = gestureFeatures.add_measurement(raw);
+#ifdef GESTURE_RECORDING
+  if (gestureFeatures.m_decimated) {
+    const mvmt::GestureFeatureExtractor::sample_t &sample = gestureFeatures.latest();
+    Serial.printf("G,%d,%d,%d,%d,%d,%d\n", sample[0], sample[1], sample[2], sample[3], sample[4], sample[5]);
+  }
+#endif
+  if (!windowReady)
+    return;
+  size_t recognized = gestureNetwork.classify(gestureFeatures.get_current());
+  mvmt::Gesture gesture = mvmt::Gesture(gestureTrigger.add_measurement(recognized));
+  // Every window costs the same, so going over budget means the model or the clock has changed, not the motion
+  uint32_t cycles = ESP.getCycleCount() - startCycles;
+  if (cycles > gestureCyclesWorst) {
+    gestureCyclesWorst = cycles;
+    if (cycles > GESTURE_CYCLE_BUDGET)
+      Serial.printf("GESTURE WINDOW OVER BUDGET: %u of %u cycles\n", cycles, GESTURE_CYCLE_BUDGET);
+  }
+  if (!gestureEnableState)
+    return;
+  mouseEvent_t events[2];
+  size_t eventCount = 2;
+  switch (gesture) {
+  case mvmt::Gesture::FLICK_LEFT:
+    events[0] = mouseEvent_t::BACK_PRESS;
+    events[1] = mouseEvent_t::BACK_RELEASE;
+    break;
+  case mvmt::Gesture::TWIST:
+    // Scrolling is held with its touch pad, so twisting toggles it rather than pressing and releasing
+    events[0] = scrollEnableState ? mouseEvent_t::SCROLL_RELEASE : mouseEvent_t::SCROLL_PRESS;
+    eventCount = 1;
+    break;
+  case mvmt::Gesture::SHAKE:
+    events[0] = mouseEvent_t::LOCK_PRESS;
+    events[1] = mouseEvent_t::LOCK_RELEASE;
+    break;
+  default:
+    return;
+  }
+  for (size_t i = 0; i < eventCount; i++)
+    xQueueSend(mouseEvents, &events[i], 0);
+}
+#endif
+
+// Pass one axis of filtered acceleration through the cursor pipeline, giving counts of motion
+float mouseCurve(accel_t::Scalar value) {
+  cursorPipeline.add_measurement(value);
+  return cursorPipeline.get_current();
+}
+
+#ifndef ORIENTATION_POINTING
+// Smooth a batch of raw accelerometer samples, oldest first, through every filter that may drive the cursor. The
+// samples are overwritten along the way.
+void smoothAccel(accel_t *samples, size_t count) {
+#ifdef TREMOR_FILTER
+  for (size_t i = 0; i < count; i++) {
+    accel_tremor.add_measurement(samples[i]);
+    samples[i] = accel_tremor.get_current();
+  }
+#endif
+  accel_readings.add_measurements(samples, count);
+#ifdef ADAPTIVE_SMOOTHING
+  accel_adaptive.add_measurements(samples, count);
+#endif
+}
+
+// Get the smoothed acceleration from whichever filter is selected - both are kept running so switching is seamless
+accel_t filteredAccel() {
+#ifdef ADAPTIVE_SMOOTHING
+  if (adaptiveSmoothingState)
+    return accel_adaptive.get_current();
+#endif
+  return accel_readings.get_current();
+}
+
+// Gather the latest smoothed motion, extrapolated forward by the prediction horizon
+motion_t predictedMotion() {
+  float horizon = predictionHorizon;
+  accel_t accel = filteredAccel();
+#ifdef TILT_PREDICTION
+  // The predictor belongs to the sensor task, so the slider's horizon is applied here rather than from the menu
+  accel_predictor.set_horizon(horizon);
+  accel_predictor.add_measurement(accel);
+  accel = accel_predictor.get_current();
+#endif
+  // The gyroscope measures the rate of turning directly, so the orientation is extrapolated from it without tracking
+  return {accel, mvmt::integrate_rate(gyroOrientation, gyro_readings.get_current(), horizon), stillness.still()};
 }
 
+// Publish the latest motion for loop() to report, timing the work done only at the report rate
+// @return The CPU cycles the work took
+uint32_t publishMotion() {
+  uint32_t startCycles = ESP.getCycleCount();
+  motion_t motion = predictedMotion();
+  reportCycles = ESP.getCycleCount() - startCycles;
+  reportRate.tick(micros());
+  xQueueOverwrite(motionQueue, &motion);
+  return reportCycles;
+}
+
+// Convert raw gyroscope counts to an angular rate in rad/s
+Eigen::Vector3f toRate(int16_t x, int16_t y, int16_t z) {
+  constexpr float RAD_PER_SEC_PER_COUNT = GYRO_FULL_SCALE / 32768 * DEG_TO_RAD;
+  return Eigen::Vector3f(x, y, z) * RAD_PER_SEC_PER_COUNT;
+}
+
+// Convert a raw die temperature reading to degrees C, by the formula in the ICM-20948 datasheet
+float toTemperature(int16_t raw) {
+  constexpr float ROOM_TEMPERATURE_OFFSET = 21; // Reading at 21 degrees C
+  constexpr float COUNTS_PER_DEGREE = 333.87;
+  return (raw - ROOM_TEMPERATURE_OFFSET) / COUNTS_PER_DEGREE + 21;
+}
+
+// Remove the gyroscope's bias from one raw rate, smooth it, and turn the integrated orientation by it
+void integrateGyro(const Eigen::Vector3f &rate) {
+  // Lying still, the whole reading is bias, so it teaches the thermal model the bias at the current temperature
+  if (stillness.still())
+    gyroThermalBias.learn(rate);
+  gyroPipeline.add_measurement(rate);
+  // Zero-velocity update: while the board lies still, any rate left over is bias, so it mustn't turn the orientation
+  if (!stillness.still())
+    gyroOrientation = mvmt::integrate_rate(gyroOrientation, gyroPipeline.get_current(), float(IMU_TIME_DELTA));
+}
+#endif
+
+#if defined(DMP_POINTING)
+// Define the sensor task, which periodically drains the orientations the IMU's DMP has queued in its FIFO, and a place
+// to store its handle
+TaskHandle_t sensorTaskHandle;
+void sensorTask(void *pvParameters) {
+  TickType_t lastWakeTime = xTaskGetTickCount();
+  for (;;) {
+    vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(FIFO_DRAIN_PERIOD));
+    icm_20948_DMP_data_t frame;
+    Eigen::Quaternionf orientation;
+    uint32_t orientationCount = 0;
+    do {
+      icm.readDMPdataFromFIFO(&frame);
+      if ((icm.status == ICM_20948_Stat_Ok || icm.status == ICM_20948_Stat_FIFOMoreDataAvail) &&
+          (frame.header & DMP_header_bitmap_Quat6)) {
+        orientation = mvmt::quaternion_from_q30<float>(frame.Quat6.Data.Q1, frame.Quat6.Data.Q2, frame.Quat6.Data.Q3);
+        orientationCount++;
+      }
+    } while (icm.status == ICM_20948_Stat_FIFOMoreDataAvail);
+    if (!orientationCount)
+      continue;
+    imuRate.tick(micros(), orientationCount);
+    motion_t motion = {accel_t::Zero(), orientation, false};
+    xQueueOverwrite(motionQueue, &motion);
+  }
+}
+#elif defined(FIFO_ACQUISITION)
+// Define the sensor task, which periodically drains every sample queued in the IMU's FIFO, and a place to store its
+// handle
+TaskHandle_t sensorTaskHandle;
+void sensorTask(void *pvParameters) {
+  uint8_t fifoBytes[FIFO_BURST_BYTES];
+  accel_t accelSamples[FIFO_BURST_BYTES / FIFO_SAMPLE_BYTES];
+  TickType_t lastWakeTime = xTaskGetTickCount();
+  for (;;) {
+    vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(FIFO_DRAIN_PERIOD));
+    uint16_t fifoCount = 0;
+    if (icm.getFIFOcount(&fifoCount) != ICM_20948_Stat_Ok)
+      continue;
+    fifoCount -= fifoCount % FIFO_SAMPLE_BYTES; // Leave any partially written sample for next time
+    if (!fifoCount)
+      continue;
+    imuRate.tick(micros(), fifoCount / FIFO_SAMPLE_BYTES);
+    // Temperature changes far too slowly to need queueing with every sample, so it is read once per drain
+    uint8_t temperatureBytes[2];
+    icm.setBank(0);
+    if (icm.read(AGB0_REG_TEMP_OUT_H, temperatureBytes, sizeof(temperatureBytes)) == ICM_20948_Stat_Ok)
+      gyroThermalBias.set_temperature(toTemperature(int16_t(temperatureBytes[0] << 8 | temperatureBytes[1])));
+    while (fifoCount) {
+      uint8_t burstBytes = std::min<uint16_t>(fifoCount, FIFO_BURST_BYTES);
+      if (icm.readFIFO(fifoBytes, burstBytes) != ICM_20948_Stat_Ok) {
+        icm.resetFIFO(); // A failed read leaves the FIFO misaligned, so start over with fresh samples
+        break;
+      }
+      uint8_t sampleCount = burstBytes / FIFO_SAMPLE_BYTES;
+      uint8_t unsmoothed = 0; // Index of the first sample not yet added to the smoothing filters
+      uint32_t startCycles = ESP.getCycleCount();
+      uint32_t publishingCycles = 0;
+      for (uint8_t i = 0; i < sampleCount; i++) {
+        const uint8_t *record = fifoBytes + i * FIFO_SAMPLE_BYTES;
+        int16_t x = record[0] << 8 | record[1], y = record[2] << 8 | record[3], z = record[4] << 8 | record[5];
+        int16_t gx = record[6] << 8 | record[7], gy = record[8] << 8 | record[9], gz = record[10] << 8 | record[11];
+        Eigen::Vector3f rate = toRate(gx, gy, gz);
+        calibrateRest(Eigen::Vector3f(x, y, z), rate);
+        stillness.add_measurement(Eigen::Vector3f(x, y, z), rate);
+        detectTap(Eigen::Vector3f(x, y, z), (fifoCount - burstBytes) / FIFO_SAMPLE_BYTES + sampleCount - 1 - i);
+        recognizeGesture({x, y, z, gx, gy, gz});
+        accelSamples[i] = toAccel(x, y, z);
+        // The orientation is integrated from each filtered rate in turn, so the gyroscope can't be added in a batch
+        integrateGyro(rate);
+        // At each output instant, bring the tilt smoothing up to date with this sample and publish the motion
+        if (reportDecimator.tick()) {
+          smoothAccel(accelSamples + unsmoothed, i + 1 - unsmoothed);
+          unsmoothed = i + 1;
+          publishingCycles += publishMotion();
+        }
+      }
+      smoothAccel(accelSamples + unsmoothed, sampleCount - unsmoothed);
+      sampleCycles = (ESP.getCycleCount() - startCycles - publishingCycles) / sampleCount;
+      fifoCount -= burstBytes;
+    }
+  }
+}
+#else
+// Define the sensor task, which is woken by the IMU's data ready interrupt, and a place to store its handle
+TaskHandle_t sensorTaskHandle;
+void IRAM_ATTR imuISR() {
+  BaseType_t wokeTask = pdFALSE;
+  vTaskNotifyGiveFromISR(sensorTaskHandle, &wokeTask);
+  portYIELD_FROM_ISR(wokeTask);
+}
+
+void sensorTask(void *pvParameters) {
+#ifdef FUSION_POINTING
+  Eigen::Vector3f lastRawMag = Eigen::Vector3f::Zero();
+#endif
+  for (;;) {
+    // Sleep until the IMU signals a new sample - if the interrupt never comes, check the IMU directly
+    if (!ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IMU_INT_TIMEOUT))) {
+      if (!icm.dataReady())
+        continue;
+      missedInterrupts++;
+    }
+    icm.getAGMT();
+    imuRate.tick(micros());
+#ifdef FUSION_POINTING
+    // The magnetometer's y and z axes point the opposite way to the accelerometer's and gyroscope's
+    Eigen::Vector3f gyro(icm.gyrX(), icm.gyrY(), icm.gyrZ());
+    Eigen::Vector3f accel(icm.accX(), icm.accY(), icm.accZ());
+    Eigen::Vector3f rawMag(icm.magX(), -icm.magY(), -icm.magZ());
+    // The magnetometer only updates at 100 Hz - fit each reading once, not once per sample that repeats it
+    if (rawMag != lastRawMag) {
+      lastRawMag = rawMag;
+      if (magCalibrator.add_measurement(rawMag))
+        xQueueOverwrite(magCalibrationQueue, &magCalibrator.get_current());
+    }
+    Eigen::Vector3f mag = magCalibrator.get_current().apply(rawMag);
+    Eigen::Vector3f rate = gyro * float(DEG_TO_RAD);
+    Eigen::Vector3f accelCounts(icm.agmt.acc.axes.x, icm.agmt.acc.axes.y, icm.agmt.acc.axes.z);
+    calibrateRest(accelCounts, rate);
+    stillness.add_measurement(accelCounts, rate);
+    detectTap(accelCounts, 0);
+    recognizeGesture({icm.agmt.acc.axes.x, icm.agmt.acc.axes.y, icm.agmt.acc.axes.z, icm.agmt.gyr.axes.x,
+                      icm.agmt.gyr.axes.y, icm.agmt.gyr.axes.z});
+    rate -= restCalibrator.get_current().gyro_bias;
+    uint32_t startCycles = ESP.getCycleCount();
+    fusion.update(rate, accel, mag, IMU_TIME_DELTA);
+    sampleCycles = ESP.getCycleCount() - startCycles;
+    if (reportDecimator.tick()) {
+      startCycles = ESP.getCycleCount();
+      motion_t motion = {accel_t::Zero(), mvmt::integrate_rate(fusion.orientation(), rate, predictionHorizon),
+                         stillness.still()};
+      reportCycles = ESP.getCycleCount() - startCycles;
+      reportRate.tick(micros());
+      xQueueOverwrite(motionQueue, &motion);
+    }
+#else
+    uint32_t startCycles = ESP.getCycleCount();
+    Eigen::Vector3f rate = toRate(icm.agmt.gyr.axes.x, icm.agmt.gyr.axes.y, icm.agmt.gyr.axes.z);
+    Eigen::Vector3f accelCounts(icm.agmt.acc.axes.x, icm.agmt.acc.axes.y, icm.agmt.acc.axes.z);
+    calibrateRest(accelCounts, rate);
+    stillness.add_measurement(accelCounts, rate);
+    detectTap(accelCounts, 0);
+    recognizeGesture({icm.agmt.acc.axes.x, icm.agmt.acc.axes.y, icm.agmt.acc.axes.z, icm.agmt.gyr.axes.x,
+                      icm.agmt.gyr.axes.y, icm.agmt.gyr.axes.z});
+    accel_t accel = toAccel(icm.agmt.acc.axes.x, icm.agmt.acc.axes.y, icm.agmt.acc.axes.z);
+    smoothAccel(&accel, 1);
+    gyroThermalBias.set_temperature(toTemperature(icm.agmt.tmp.val));
+    integrateGyro(rate);
+    sampleCycles = ESP.getCycleCount() - startCycles;
+    if (reportDecimator.tick())
+      publishMotion();
+#endif
+  }
+}
+#endif
+#endif // NO_SENSOR
+
 // Code to run once on start up
 
 void setup() {
@@ -324,6 +1186,88 @@ void setup() {
       break;
     }
   }
+
+#ifdef DMP_POINTING
+  // Load the DMP firmware and have it fuse the accelerometer and gyroscope into game rotation vectors (orientations
+  // that ignore the magnetometer), queued in the FIFO for the sensor task
+  bool dmpReady = icm.initializeDMP() == ICM_20948_Stat_Ok;
+  // initializeDMP() samples at 55 Hz - speed the sensors up and tell the DMP, which integrates the gyro itself
+  static_assert(IMU_SAMPLE_RATE_DIVIDER >= 4, "The DMP can't fuse faster than 225 Hz");
+  ICM_20948_smplrt_t sampleRate = {IMU_SAMPLE_RATE_DIVIDER, IMU_SAMPLE_RATE_DIVIDER};
+  dmpReady &= icm.setSampleRate(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, sampleRate) == ICM_20948_Stat_Ok;
+  dmpReady &= icm.setGyroSF(IMU_SAMPLE_RATE_DIVIDER, 3) == ICM_20948_Stat_Ok; // 3 selects the +/-2000 dps range
+  dmpReady &= icm.enableDMPSensor(INV_ICM20948_SENSOR_GAME_ROTATION_VECTOR) == ICM_20948_Stat_Ok;
+  dmpReady &= icm.setDMPODRrate(DMP_ODR_Reg_Quat6, 0) == ICM_20948_Stat_Ok; // Output every orientation computed
+  dmpReady &= icm.enableFIFO() == ICM_20948_Stat_Ok;
+  dmpReady &= icm.enableDMP() == ICM_20948_Stat_Ok;
+  dmpReady &= icm.resetDMP() == ICM_20948_Stat_Ok;
+  dmpReady &= icm.resetFIFO() == ICM_20948_Stat_Ok;
+  if (!dmpReady)
+    Serial.println("DMP initialization failed");
+#else
+  // Sample at the rate, through the on-chip low-pass filters and at the ranges the sensor profile calls for
+  ICM_20948_smplrt_t sampleRate = {IMU_SAMPLE_RATE_DIVIDER, IMU_SAMPLE_RATE_DIVIDER};
+  icm.setSampleRate(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, sampleRate);
+  ICM_20948_dlpcfg_t lowPassConfig = {ACCEL_LOW_PASS, GYRO_LOW_PASS};
+  icm.setDLPFcfg(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, lowPassConfig);
+  icm.enableDLPF(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, true);
+  ICM_20948_fss_t fullScale = {};
+  fullScale.a = ACCEL_RANGE;
+  fullScale.g = GYRO_RANGE;
+  icm.setFullScale(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, fullScale);
+  Serial.printf("%s SENSOR PROFILE: %.1f Hz SAMPLED, %.1f Hz PUBLISHED\n", SENSOR_PROFILE_NAME, 1 / IMU_TIME_DELTA,
+                1 / REPORT_TIME_DELTA);
+#ifdef GESTURE_RECOGNITION
+  Serial.printf("GESTURES: %.1f Hz, BUDGET %u CYCLES PER WINDOW\n", 1 / (IMU_TIME_DELTA * GESTURE_DECIMATION),
+                GESTURE_CYCLE_BUDGET);
+#endif
+#endif
+
+#if defined(FIFO_ACQUISITION)
+  // Queue every accelerometer and gyroscope sample in the IMU's FIFO, to be read in bursts by the sensor task
+  ICM_20948_FIFO_EN_2_t fifoSources = {};
+  fifoSources.ACCEL_FIFO_EN = 1;
+  fifoSources.GYRO_X_FIFO_EN = 1;
+  fifoSources.GYRO_Y_FIFO_EN = 1;
+  fifoSources.GYRO_Z_FIFO_EN = 1;
+  icm.setBank(0);
+  icm.write(AGB0_REG_FIFO_EN_2, reinterpret_cast<uint8_t *>(&fifoSources), 1);
+  icm.setFIFOmode(false); // Stream mode - keep writing samples even if a drain is late
+  icm.enableFIFO(true);
+  icm.resetFIFO();
+#elif !defined(DMP_POINTING)
+  // Pulse the INT pin low whenever a new sample is ready
+  icm.cfgIntActiveLow(true);
+  icm.cfgIntOpenDrain(false);
+  icm.cfgIntLatch(false);
+  icm.intEnableRawDataReady(true);
+#endif
+
+#ifdef FUSION_POINTING
+  // Start from the magnetometer calibration saved before the last reboot, rather than waiting for a fresh fit
+  mvmt::MagCalibration savedCalibration;
+  calibrationStore.begin("mvmt", true);
+  if (calibrationStore.getBytesLength("mag") == sizeof(savedCalibration)) {
+    calibrationStore.getBytes("mag", &savedCalibration, sizeof(savedCalibration));
+    magCalibrator.set_current(savedCalibration);
+    Serial.println("Loaded saved magnetometer calibration");
+  }
+  calibrationStore.end();
+#endif
+
+  // Dispatch the sensor task - it must exist before the interrupt that wakes it is attached
+  xTaskCreatePinnedToCore(sensorTask,        // Task code is in the sensorTask() function
+                          "Sensor Task",     // Descriptive task name
+                          4000,              // Stack depth
+                          NULL,              // Parameter to function (unnecessary here)
+                          3,                 // Task priority - above loop() and the draw task so samples aren't late
+                          &sensorTaskHandle, // Variable to hold new task handle
+                          1                  // Pin the task to the core that doesn't handle WiFi/Bluetooth
+  );
+#if !defined(FIFO_ACQUISITION) && !defined(DMP_POINTING)
+  pinMode(IMU_INT_PIN, INPUT_PULLUP);
+  attachInterrupt(IMU_INT_PIN, imuISR, FALLING);
+#endif
 #endif
 
   Serial.println("I was once an adventurer like you,");
@@ -373,6 +1317,10 @@ void loop() {
     mouseEvent_t messageReceived;
     xQueueReceive(mouseEvents, &messageReceived, 0);
     inputViewPage.onMouseEvent(messageReceived); // Update input view page
+#ifdef TAP_DETECTION
+    if (tapClickPending && (messageReceived == mouseEvent_t::LMB_PRESS || messageReceived == mouseEvent_t::RMB_PRESS))
+      reportTapLatency(messageReceived);
+#endif
     if (mouseEnableState) {                      // If there is a button event
       switch (messageReceived) {
       case mouseEvent_t::LMB_PRESS:
@@ -403,9 +1351,19 @@ void loop() {
         Serial.println("SCROLL DISBALED");
         scrollEnableState = false;
         break;
+      case mouseEvent_t::BACK_PRESS:
+        Serial.println("BACK_PRESS");
+        mouse.press(MOUSE_BACK);
+        break;
+      case mouseEvent_t::BACK_RELEASE:
+        Serial.println("BACK_RELEASE");
+        mouse.release(MOUSE_BACK);
+        break;
       case mouseEvent_t::CALIBRATE_PRESS:
         Serial.println("CALIBRATING...");
-#ifndef NO_SENSOR
+#ifdef REST_CALIBRATION
+        // The sensor task calibrates in the background once the board has been held still for long enough
+        restCalibrationRequested = true;
 #endif
         break;
       default:
@@ -421,18 +1379,52 @@ void loop() {
     xQueueSend(mouseQueue, &messageReceived, 0);
   }
 #ifndef NO_SENSOR
-  // Move the mouse according to incoming IMU data
-  if (icm.dataReady() && mouseEnableState) {
-    icm.getAGMT();
-    accel_readings.add_measurement(Eigen::Vector3d(icm.accX(), icm.accY(), icm.accZ()));
-    if (!scrollEnableState) {
-      mouse.move(mouseCurve(-accel_readings.get_current().x() * MOUSE_SENSITIVITY),
-                 mouseCurve(-accel_readings.get_current().y() * MOUSE_SENSITIVITY));
+  // Move the mouse according to motion published by the sensor task - waiting on it paces loop() at the sample rate
+  motion_t motion;
+  if (xQueueReceive(motionQueue, &motion, pdMS_TO_TICKS(MOTION_WAIT_TIME))) {
+    // Follow the orientation even while pointing by tilt, so switching to pointing by turning doesn't jump
+    Eigen::Vector3f turn = orientationKnown ? mvmt::rotation_between(lastOrientation, motion.orientation)
+                                            : Eigen::Vector3f::Zero();
+    lastOrientation = motion.orientation;
+    orientationKnown = true;
+    if (motion.still) {
+      // Lying still, whatever motion is left is noise or drift, so drop it rather than let it creep the cursor along
+      pendingMotion.clear();
+    } else if (mouseEnableState && turnEnableState) {
+      // Yawing moves the mouse sideways and pitching moves it up and down, in the same directions as tilting does
+      if (!scrollEnableState) {
+        pendingMotion.add(-turn.z() * POINTING_SENSITIVITY, -turn.x() * POINTING_SENSITIVITY, 0, 0);
+      } else {
+        pendingMotion.add(0, 0, turn.x() * POINTING_SCROLL_SENSITIVITY, -turn.z() * POINTING_SCROLL_SENSITIVITY);
+      }
+    } else if (mouseEnableState) {
+      if (!scrollEnableState) {
+        pendingMotion.add(mouseCurve(-motion.accel.x()), mouseCurve(-motion.accel.y()), 0, 0);
+      } else {
+        pendingMotion.add(0, 0, mouseCurve(motion.accel.y()), mouseCurve(-motion.accel.x()));
+      }
     } else {
-      mouse.move(0, 0, mouseCurve(accel_readings.get_current().y() * MOUSE_SENSITIVITY),
-                 mouseCurve(-accel_readings.get_current().x() * MOUSE_SENSITIVITY));
+      pendingMotion.clear();
+    }
+    // Send the whole counts of movement, leaving fractions for later samples to add to
+    uint8_t reportCount = 0;
+    for (; reportCount < MAX_REPORTS_PER_SAMPLE && pendingMotion.ready(); reportCount++) {
+      mvmt::MouseReport report = pendingMotion.take();
+      mouse.move(report.x, report.y, report.wheel, report.h_wheel);
     }
+    reportsSent += reportCount;
+    if (!reportCount)
+      reportsSuppressed++;
+  }
+#endif
+#ifdef FUSION_POINTING
+  // Save the newest magnetometer calibration, so the next boot doesn't have to calibrate from scratch
+  mvmt::MagCalibration magCalibration;
+  if (millis() - magCalibrationSaveTime > MAG_SAVE_INTERVAL && xQueueReceive(magCalibrationQueue, &magCalibration, 0)) {
+    calibrationStore.begin("mvmt", false);
+    calibrationStore.putBytes("mag", &magCalibration, sizeof(magCalibration));
+    calibrationStore.end();
+    magCalibrationSaveTime = millis();
   }
-  delay(5);
 #endif
 }
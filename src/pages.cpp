@@ -15,6 +15,7 @@
 #include "io.h"
 #include "mouse.h"
 #include "pages.h"
+#include "rate_monitor.h"
 
 // Set memory space allocated to each Elk script in a DOMPage
 const size_t ELK_STACK = 4096;
@@ -22,6 +23,15 @@ const size_t ELK_STACK = 4096;
 // Allow interaction with the externally declared mouseQueue
 extern xQueueHandle mouseQueue;
 
+// Allow access to the externally declared IMU sample rate statistics
+extern RateMonitor imuRate;
+extern volatile uint32_t missedInterrupts;
+extern RateMonitor reportRate;
+extern uint32_t sampleCycles;
+extern uint32_t reportCycles;
+extern uint32_t reportsSent;
+extern uint32_t reportsSuppressed;
+
 // Not much to do for a blank page
 BlankPage::BlankPage(Display *display, DisplayManager *displayManager, const char *pageName)
     : DisplayPage(display, displayManager, pageName) {}
@@ -255,6 +265,11 @@ DebugPage::DebugPage(Display *display, DisplayManager *displayManager, const cha
 // Great place for debug stuff
 void DebugPage::draw() {
   display->textFormat(2, TFT_WHITE);
+  display->buffer->drawString("IMU: " + String(imuRate.rate(), 1) + ">" + String(reportRate.rate(), 1) + " Hz", 10, 24);
+  display->buffer->drawString("Jitter: " + String(imuRate.jitter(), 0) + " us", 10, 46);
+  display->buffer->drawString("INT missed: " + String(missedInterrupts), 10, 68);
+  display->buffer->drawString("Cyc: " + String(sampleCycles) + "+" + String(reportCycles), 10, 90);
+  display->buffer->drawString("HID: " + String(reportsSent) + "/" + String(reportsSuppressed), 10, 112);
   // frameCounter++; No animations being currently tested
 };
 
@@ -0,0 +1,36 @@
+#include "rate_monitor.h"
+#include <Arduino.h>
+
+// Weight given to each new interval - the statistics settle over roughly 1 / RATE_SMOOTHING events
+const float RATE_SMOOTHING = 1.0 / 64;
+
+RateMonitor::RateMonitor() : lastTimestamp(0), meanInterval(0), intervalVariance(0), eventCount(0) {}
+
+// Record events at the given timestamp in microseconds, typically from micros(). Events observed together, such as a
+// burst of samples read from a FIFO, are treated as evenly spaced since the last call.
+void RateMonitor::tick(uint32_t timestamp, uint32_t events) {
+  if (events == 0)
+    return;
+  float interval = float(timestamp - lastTimestamp) / events; // Unsigned subtraction handles micros() rollover
+  lastTimestamp = timestamp;
+  bool first = eventCount == 0;
+  eventCount += events;
+  if (first)
+    return; // There is no interval until the second observation
+  if (meanInterval == 0) {
+    meanInterval = interval;
+    return;
+  }
+  float deviation = interval - meanInterval;
+  meanInterval += RATE_SMOOTHING * deviation;
+  intervalVariance += RATE_SMOOTHING * (deviation * deviation - intervalVariance);
+}
+
+// Get the average event rate in Hz
+float RateMonitor::rate() { return meanInterval > 0 ? 1e6 / meanInterval : 0; }
+
+// Get the standard deviation of the time between events in microseconds
+float RateMonitor::jitter() { return sqrtf(intervalVariance); }
+
+// Get the total number of events recorded
+uint32_t RateMonitor::count() { return eventCount; }
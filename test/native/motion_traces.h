@@ -0,0 +1,160 @@
+#ifndef MVMT_TEST_MOTION_TRACES_HPP
+#define MVMT_TEST_MOTION_TRACES_HPP
+
+// Synthetic tilt traces shared by the native tests, standing in for recordings until real ones are committed. Each
+// trace is generated from a fixed seed, so the numbers the tests report are reproducible. Tilt is in mg, sampled at the
+// sensor task's 225 Hz.
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace traces {
+
+constexpr double TIME_DELTA = 5 / 1125.0; // Time between samples in seconds
+constexpr double NOISE = 2.0;             // Standard deviation of the sensor noise in mg
+
+/// @brief A tilt trace: what the hand did, and what the accelerometer measured.
+struct Trace {
+  std::vector<double> truth;
+  std::vector<double> measured;
+};
+
+/// @brief Sample a tilt trajectory and add sensor noise to it.
+/// @param trajectory A function mapping time in seconds to the true tilt in mg
+/// @param duration The length of the trace in seconds
+/// @param seed The seed of the noise generator
+template <typename Trajectory> Trace make_trace(Trajectory trajectory, double duration, unsigned seed = 20948) {
+  std::mt19937 generator(seed);
+  std::normal_distribution<double> noise(0.0, NOISE);
+  Trace trace;
+  for (std::size_t i = 0; i * TIME_DELTA < duration; i++) {
+    double tilt = trajectory(i * TIME_DELTA);
+    trace.truth.push_back(tilt);
+    trace.measured.push_back(tilt + noise(generator));
+  }
+  return trace;
+}
+
+/// @brief The minimum-jerk profile of a reach, going from 0 to 1 as progress goes from 0 to 1, which is how hands move
+/// between targets.
+inline double minimum_jerk(double progress) {
+  if (progress <= 0) {
+    return 0;
+  }
+  if (progress >= 1) {
+    return 1;
+  }
+  return progress * progress * progress * (10 - 15 * progress + 6 * progress * progress);
+}
+
+/// @brief The board held level and still.
+inline Trace hold() {
+  return make_trace([](double) { return 0.0; }, 3.0);
+}
+
+constexpr double RAMP_START = 0.5; // Time the ramp starts tilting, in seconds
+constexpr double RAMP_SPEED = 500; // Tilting speed in mg/s
+
+/// @brief The board tilted at a steady speed after a pause.
+inline Trace ramp() {
+  return make_trace([](double t) { return t < RAMP_START ? 0.0 : RAMP_SPEED * (t - RAMP_START); }, 2.5);
+}
+
+constexpr double FLICK_START = 0.5;     // Time the flick starts, in seconds
+constexpr double FLICK_DURATION = 0.06; // Duration of the flick, in seconds
+constexpr double FLICK_SIZE = 300;      // Tilt reached by the flick, in mg
+
+/// @brief A quick flick to a new tilt after a pause, which is then held.
+inline Trace flick() {
+  return make_trace(
+      [](double t) { return FLICK_SIZE * minimum_jerk((t - FLICK_START) / FLICK_DURATION); }, 1.5);
+}
+
+/// @brief Aiming around a screen: minimum-jerk reaches of up to 300 mg separated by pauses, with physiological tremor.
+/// @param duration The length of the trace in seconds
+inline Trace reaches(double duration) {
+  // Lay out the reaches up front from their own generator, so the trajectory is a pure function of time
+  struct Reach {
+    double start, length, from, to;
+  };
+  std::vector<Reach> plan;
+  std::mt19937 generator(225);
+  std::uniform_real_distribution<double> target(-300, 300), length(0.15, 0.5), pause(0.1, 0.6);
+  double time = 0.2, tilt = 0;
+  while (time < duration) {
+    Reach reach{time, length(generator), tilt, target(generator)};
+    plan.push_back(reach);
+    tilt = reach.to;
+    time += reach.length + pause(generator);
+  }
+  return make_trace(
+      [plan](double t) {
+        double tilt = 0;
+        for (const auto &reach : plan) {
+          if (t < reach.start) {
+            break;
+          }
+          tilt = reach.from + (reach.to - reach.from) * minimum_jerk((t - reach.start) / reach.length);
+        }
+        return tilt + 3 * std::sin(2 * M_PI * 9 * t);
+      },
+      duration);
+}
+
+/// @brief Run a filter over a trace's measurements, collecting its output after every sample.
+template <typename Filter> std::vector<double> run(Filter &filter, const Trace &trace) {
+  std::vector<double> output;
+  output.reserve(trace.measured.size());
+  for (double sample : trace.measured) {
+    filter.add_measurement(sample);
+    output.push_back(filter.get_current());
+  }
+  return output;
+}
+
+/// @brief Get the RMS difference between a filter's output and the truth, from a given time on.
+/// @param ahead How far ahead of each output the truth is compared, in seconds, rounded to whole samples
+inline double rms_error(const std::vector<double> &output, const Trace &trace, double from, double ahead = 0) {
+  auto shift = static_cast<std::size_t>(std::lround(ahead / TIME_DELTA));
+  double sum = 0;
+  std::size_t count = 0;
+  for (auto i = static_cast<std::size_t>(from / TIME_DELTA); i + shift < output.size(); i++) {
+    double error = output[i] - trace.truth[i + shift];
+    sum += error * error;
+    count++;
+  }
+  return std::sqrt(sum / count);
+}
+
+/// @brief Get how far a filter's output trails a steady ramp, in seconds, averaged over the second half of the ramp
+/// once the filter has caught up to its speed.
+inline double ramp_lag(const std::vector<double> &output, const Trace &trace) {
+  double sum = 0;
+  std::size_t count = 0;
+  for (std::size_t i = (RAMP_START + trace.truth.size() * TIME_DELTA) / 2 / TIME_DELTA; i < output.size(); i++) {
+    sum += trace.truth[i] - output[i];
+    count++;
+  }
+  return sum / count / RAMP_SPEED;
+}
+
+/// @brief Get the time at which a signal first crosses a level, interpolating between samples.
+inline double crossing_time(const std::vector<double> &signal, double level) {
+  for (std::size_t i = 1; i < signal.size(); i++) {
+    if (signal[i] >= level) {
+      return (i - 1 + (level - signal[i - 1]) / (signal[i] - signal[i - 1])) * TIME_DELTA;
+    }
+  }
+  return INFINITY;
+}
+
+/// @brief Get how far a filter's output trails a flick, in seconds, measured where each crosses half the flick.
+inline double flick_lag(const std::vector<double> &output, const Trace &trace) {
+  return crossing_time(output, FLICK_SIZE / 2) - crossing_time(trace.truth, FLICK_SIZE / 2);
+}
+
+} // namespace traces
+
+#endif
@@ -0,0 +1,101 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+
+#include "bias_estimator.h"
+#include "orientation.h"
+
+// Gyroscope bias learning as configured in main.cpp, sampled at 225 Hz
+constexpr float TIME_DELTA = 5 / 1125.0;
+constexpr float STILL_THRESHOLD = 0.035;
+constexpr float MAX_BIAS = 0.2;
+constexpr float STILL_TIME = 0.25;
+constexpr float BIAS_TIME_CONSTANT = 2.0;
+const Eigen::Vector3f BIAS(0.02, -0.03, 0.08); // Zero-rate offset in rad/s, near the ICM-20948's 5 dps on one axis
+constexpr float NOISE = 0.003;                 // Rate noise in rad/s
+
+/// @brief A gyroscope that reports its true rate plus a constant bias and white noise.
+class Gyro {
+  std::mt19937 m_generator{20948};
+  std::normal_distribution<float> m_noise{0.0f, NOISE};
+
+public:
+  Eigen::Vector3f read(const Eigen::Vector3f &rate) {
+    return rate + BIAS + Eigen::Vector3f(m_noise(m_generator), m_noise(m_generator), m_noise(m_generator));
+  }
+};
+
+/// @brief Feed the estimator samples of a constant true rate for a while.
+void hold(mvmt::BiasEstimator<Eigen::Vector3f> &estimator, Gyro &gyro, const Eigen::Vector3f &rate, float seconds) {
+  for (int i = 0; i < seconds / TIME_DELTA; i++) {
+    estimator.add_measurement(gyro.read(rate));
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_bias_settles_while_still() {
+  mvmt::BiasEstimator<Eigen::Vector3f> estimator(STILL_THRESHOLD, MAX_BIAS, STILL_TIME, BIAS_TIME_CONSTANT,
+                                                 TIME_DELTA, Eigen::Vector3f::Zero());
+  Gyro gyro;
+  hold(estimator, gyro, Eigen::Vector3f::Zero(), 1.0f);
+  float error = (estimator.get_current() - BIAS).norm();
+  char message[64];
+  snprintf(message, sizeof(message), "bias error after 1 s still: %.2f mrad/s", 1000 * error);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.002, error);
+}
+
+void test_motion_does_not_leak_into_bias() {
+  mvmt::BiasEstimator<Eigen::Vector3f> estimator(STILL_THRESHOLD, MAX_BIAS, STILL_TIME, BIAS_TIME_CONSTANT,
+                                                 TIME_DELTA, Eigen::Vector3f::Zero());
+  Gyro gyro;
+  hold(estimator, gyro, Eigen::Vector3f::Zero(), 1.0f);
+  Eigen::Vector3f settled = estimator.get_current();
+  // Deliberate turns held steady for far longer than it takes the bias to start learning, which only their size
+  // tells apart from an offset
+  hold(estimator, gyro, Eigen::Vector3f(0, 1.0, 0), 1.0f);
+  hold(estimator, gyro, Eigen::Vector3f(0.3, 0, -0.2), 1.0f);
+  TEST_ASSERT_LESS_THAN_DOUBLE(1e-6, (estimator.get_current() - settled).norm());
+}
+
+void test_corrected_orientation_holds_still() {
+  mvmt::BiasEstimator<Eigen::Vector3f> estimator(STILL_THRESHOLD, MAX_BIAS, STILL_TIME, BIAS_TIME_CONSTANT,
+                                                 TIME_DELTA, Eigen::Vector3f::Zero());
+  Gyro gyro;
+  hold(estimator, gyro, Eigen::Vector3f::Zero(), 1.0f);
+  hold(estimator, gyro, Eigen::Vector3f(0, 1.0, 0), 2.0f);
+  // Integrate the corrected rate while holding still: only noise and the residual bias should turn the orientation
+  Eigen::Quaternionf orientation = Eigen::Quaternionf::Identity();
+  for (int i = 0; i < 4.0f / TIME_DELTA; i++) {
+    Eigen::Vector3f sample = gyro.read(Eigen::Vector3f::Zero());
+    estimator.add_measurement(sample);
+    orientation = mvmt::integrate_rate(orientation, estimator.remove(sample), TIME_DELTA);
+  }
+  float drift = Eigen::AngleAxisf(orientation).angle();
+  char message[64];
+  snprintf(message, sizeof(message), "drift over 4 s still: %.2f mrad", 1000 * drift);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.002, drift);
+}
+
+void test_integrate_rate_turns_at_constant_rate() {
+  Eigen::Quaternionf orientation = Eigen::Quaternionf::Identity();
+  for (int i = 0; i < 225; i++) {
+    orientation = mvmt::integrate_rate(orientation, Eigen::Vector3f(0, 0, 0.5), TIME_DELTA);
+  }
+  Eigen::AngleAxisf turned(orientation);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.5, turned.angle());
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 1.0, turned.axis().z());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bias_settles_while_still);
+  RUN_TEST(test_motion_does_not_leak_into_bias);
+  RUN_TEST(test_corrected_orientation_holds_still);
+  RUN_TEST(test_integrate_rate_turns_at_constant_rate);
+  return UNITY_END();
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+#include <vector>
+
+#include "fixed_point.h"
+#include "mouse_curve.h"
+
+// The exponential acceleration profile as configured in main.cpp: tilt in mg is scaled into the curve's input, and the
+// table spans the accelerometer's full scale
+constexpr double ACCEL_FULL_SCALE = 2000;
+constexpr double MOUSE_SENSITIVITY = 0.003;
+constexpr std::size_t SEGMENTS = 64;
+constexpr double CURVE_RANGE = MOUSE_SENSITIVITY * ACCEL_FULL_SCALE;
+constexpr std::size_t SAMPLES = 1 << 16;
+
+template <typename T> using table_t = mvmt::CurveTable<T, SEGMENTS>;
+
+template <typename T> table_t<T> exponential() {
+  return table_t<T>::sample([](double x) { return mvmt::mouse_curve(x); }, CURVE_RANGE);
+}
+
+/// @brief Convert a tilt in mg to the curve's input as main.cpp does: scaled in the motion representation for floating
+/// point, or as a fraction of full scale scaled in Q16 for fixed point.
+template <typename Scalar> auto curve_input(double mg) {
+  if constexpr (mvmt::is_fixed<Scalar>::value) {
+    return mvmt::Q16(Scalar(mg / ACCEL_FULL_SCALE)) * mvmt::Q16(MOUSE_SENSITIVITY * ACCEL_FULL_SCALE);
+  } else {
+    return static_cast<Scalar>(mg) * static_cast<Scalar>(MOUSE_SENSITIVITY);
+  }
+}
+
+/// @brief Evaluate the exponential table over the accelerometer's range in the given representation, and compare it
+/// with the double-precision table at the same input.
+/// @return The largest difference between the two, in counts
+template <typename Scalar> double max_table_difference_counts() {
+  using curve_t = decltype(curve_input<Scalar>(0));
+  const auto table = exponential<curve_t>();
+  const auto reference = exponential<double>();
+  double max_difference = 0;
+  for (double mg = -ACCEL_FULL_SCALE; mg < ACCEL_FULL_SCALE; mg += 0.25) {
+    // Inputs are compared after rounding into the representation, which is the filter's error rather than the table's
+    curve_t input = curve_input<Scalar>(mg);
+    double difference = static_cast<double>(table.evaluate(input)) - reference.evaluate(static_cast<double>(input));
+    max_difference = std::max(max_difference, std::abs(difference));
+  }
+  return max_difference;
+}
+
+/// @brief Random curve inputs over the accelerometer's range, in the given representation.
+template <typename Scalar> std::vector<decltype(curve_input<Scalar>(0))> random_inputs() {
+  std::mt19937 generator(20948);
+  std::uniform_real_distribution<double> mg(-ACCEL_FULL_SCALE, ACCEL_FULL_SCALE);
+  std::vector<decltype(curve_input<Scalar>(0))> inputs;
+  inputs.reserve(SAMPLES);
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    inputs.push_back(curve_input<Scalar>(mg(generator)));
+  }
+  return inputs;
+}
+
+/// @brief Time how long a curve takes per input, taking the fastest of several passes so a busy host doesn't skew the
+/// comparison.
+/// @return The mean time per evaluation in nanoseconds
+template <typename T, typename Curve> double time_per_input(Curve curve, const std::vector<T> &inputs) {
+  double sink = 0, fastest = INFINITY;
+  for (int pass = 0; pass < 15; pass++) {
+    auto start = std::chrono::steady_clock::now();
+    for (T input : inputs) {
+      sink += static_cast<double>(curve(input));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    fastest = std::min(fastest, std::chrono::duration<double, std::nano>(elapsed).count() / inputs.size());
+  }
+  // Keep the outputs observable so the loop can't be optimized away
+  TEST_ASSERT_TRUE(std::isfinite(sink));
+  return fastest;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_table_follows_curve() {
+  const auto table = exponential<double>();
+  double max_error = 0, max_relative = 0;
+  for (double mg = 0; mg <= ACCEL_FULL_SCALE; mg += 0.25) {
+    double x = mg * MOUSE_SENSITIVITY, expected = mvmt::mouse_curve(x);
+    double error = std::abs(table.evaluate(x) - expected);
+    max_error = std::max(max_error, error);
+    if (expected > 0.1) {
+      max_relative = std::max(max_relative, error / expected);
+    }
+  }
+  char message[96];
+  snprintf(message, sizeof(message), "%zu segments: max error %.3f counts, %.2f %% above 0.1 counts", SEGMENTS,
+           max_error, 100 * max_relative);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.5, max_error);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.01, max_relative);
+}
+
+void test_representations_match_double_table() {
+  const double float_difference = max_table_difference_counts<float>();
+  const double q15_difference = max_table_difference_counts<mvmt::Q15>();
+  const double q31_difference = max_table_difference_counts<mvmt::Q31>();
+  char message[112];
+  snprintf(message, sizeof(message), "against the double table: float %.6f, Q16 from Q15 %.4f, from Q31 %.4f counts",
+           float_difference, q15_difference, q31_difference);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.001, float_difference);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.01, q15_difference);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.01, q31_difference);
+}
+
+void test_table_is_symmetric() {
+  const auto table = exponential<double>();
+  const auto fixed_table = exponential<mvmt::Q16>();
+  for (double x = 0; x < 1.5 * CURVE_RANGE; x += 0.01) {
+    TEST_ASSERT_EQUAL_DOUBLE(-table.evaluate(x), table.evaluate(-x));
+    mvmt::Q16 fixed(x);
+    TEST_ASSERT_EQUAL((-fixed_table.evaluate(fixed)).raw, fixed_table.evaluate(-fixed).raw);
+  }
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, table.evaluate(0.0));
+  TEST_ASSERT_EQUAL(0, fixed_table.evaluate(mvmt::Q16()).raw);
+}
+
+void test_table_extrapolates_last_segment() {
+  const auto table = exponential<double>();
+  const auto fixed_table = exponential<mvmt::Q16>();
+  const double last = mvmt::mouse_curve(CURVE_RANGE);
+  const double slope = (last - mvmt::mouse_curve(CURVE_RANGE * (SEGMENTS - 1) / SEGMENTS)) * SEGMENTS / CURVE_RANGE;
+  for (double past : {0.0, 0.5, 2.0}) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, last + slope * past, table.evaluate(CURVE_RANGE + past));
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, last + slope * past,
+                              fixed_table.evaluate(mvmt::Q16(CURVE_RANGE + past)).to_double());
+  }
+}
+
+void test_curve_benchmark() {
+  const auto doubles = random_inputs<double>();
+  const auto floats = random_inputs<float>();
+  const auto fixed = random_inputs<mvmt::Q31>();
+  const auto double_table = exponential<double>();
+  const auto float_table = exponential<float>();
+  const auto fixed_table = exponential<mvmt::Q16>();
+  char message[96];
+  snprintf(message, sizeof(message), "double: mouse_curve() %.1f ns, table %.1f ns",
+           time_per_input([](double x) { return mvmt::mouse_curve(x); }, doubles),
+           time_per_input([&](double x) { return double_table.evaluate(x); }, doubles));
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "float: mouse_curve() %.1f ns, table %.1f ns",
+           time_per_input([](float x) { return mvmt::mouse_curve(x); }, floats),
+           time_per_input([&](float x) { return float_table.evaluate(x); }, floats));
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "Q16: table %.1f ns",
+           time_per_input([&](mvmt::Q16 x) { return fixed_table.evaluate(x); }, fixed));
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_table_follows_curve);
+  RUN_TEST(test_representations_match_double_table);
+  RUN_TEST(test_table_is_symmetric);
+  RUN_TEST(test_table_extrapolates_last_segment);
+  RUN_TEST(test_curve_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+#include <vector>
+
+#include "../motion_traces.h"
+#include "decimator.h"
+#include "gauss_filter.h"
+#include "motion_predictor.h"
+
+// Tilt smoothing, prediction and report decimation for each sensor profile as configured in main.cpp
+constexpr double Z_CUTOFF = 2;
+constexpr double PREDICTION_ALPHA = 0.7;
+constexpr double PREDICTION_BETA = 0.3;
+constexpr std::size_t SAMPLES = 20000;
+
+struct Profile {
+  const char *name;
+  double time_delta;      // Time between IMU samples in seconds
+  double stddev;          // Width of the accelerometer smoothing bell curve in seconds
+  std::size_t decimation; // Samples per published motion
+};
+
+const Profile PROFILES[] = {
+    {"low latency", 2 / 1125.0, 0.012, 5},
+    {"balanced", 5 / 1125.0, 0.025, 2},
+    {"balanced FIFO", 2 / 1125.0, 0.025, 5},
+    {"low power", 11 / 1125.0, 0.012, 1},
+};
+
+/// @brief Random tilts in mg, as the accelerometer might read them.
+std::vector<Eigen::Vector3d> make_tilts() {
+  std::mt19937 generator(1125);
+  std::uniform_real_distribution<double> mg(-1000, 1000);
+  std::vector<Eigen::Vector3d> tilts;
+  tilts.reserve(SAMPLES);
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    tilts.emplace_back(mg(generator), mg(generator), mg(generator));
+  }
+  return tilts;
+}
+
+/// @brief Time smoothing and prediction over random tilts, publishing motion every given number of samples, taking the
+/// fastest of several passes so a busy host doesn't skew the comparison.
+/// @return The mean time per input sample in nanoseconds
+double time_per_sample(const Profile &profile, const std::vector<Eigen::Vector3d> &tilts, std::size_t decimation) {
+  Eigen::Vector3d sink = Eigen::Vector3d::Zero();
+  double fastest = INFINITY;
+  for (int pass = 0; pass < 15; pass++) {
+    mvmt::GaussianFilter<Eigen::Vector3d> filter(profile.stddev, Z_CUTOFF, profile.time_delta,
+                                                 Eigen::Vector3d::Zero());
+    mvmt::AlphaBetaPredictor<Eigen::Vector3d> predictor(PREDICTION_ALPHA, PREDICTION_BETA,
+                                                        decimation * profile.time_delta, Eigen::Vector3d::Zero());
+    mvmt::Decimator decimator(decimation);
+    auto start = std::chrono::steady_clock::now();
+    for (const Eigen::Vector3d &tilt : tilts) {
+      filter.add_measurement(tilt);
+      if (decimator.tick()) {
+        predictor.add_measurement(filter.get_current());
+        sink += predictor.get_current();
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    fastest = std::min(fastest, std::chrono::duration<double, std::nano>(elapsed).count() / tilts.size());
+  }
+  // Keep the outputs observable so the loop can't be optimized away
+  TEST_ASSERT_TRUE(std::isfinite(sink.sum()));
+  return fastest;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_decimator_marks_every_factor_sample() {
+  mvmt::Decimator decimator(5);
+  for (int i = 0; i < 20; i++) {
+    TEST_ASSERT_EQUAL(i % 5 == 4, decimator.tick());
+  }
+  // A factor of zero is taken as one, publishing every sample
+  mvmt::Decimator every(0);
+  for (int i = 0; i < 5; i++) {
+    TEST_ASSERT_TRUE(every.tick());
+  }
+}
+
+void test_decimated_smoothing_matches_full_rate() {
+  // The bell curve is only convolved when read, so reading it at output instants alone changes nothing it outputs
+  const auto trace = traces::reaches(20);
+  mvmt::GaussianFilter<double> full_rate(0.025, Z_CUTOFF, traces::TIME_DELTA, 0.0);
+  mvmt::GaussianFilter<double> decimated(0.025, Z_CUTOFF, traces::TIME_DELTA, 0.0);
+  mvmt::Decimator decimator(2);
+  for (double tilt : trace.measured) {
+    full_rate.add_measurement(tilt);
+    double expected = full_rate.get_current();
+    decimated.add_measurement(tilt);
+    if (decimator.tick()) {
+      TEST_ASSERT_TRUE(expected == decimated.get_current());
+    }
+  }
+}
+
+void test_bell_curve_rejects_aliases() {
+  for (const Profile &profile : PROFILES) {
+    if (profile.decimation == 1) {
+      continue;
+    }
+    // Anything the bell curve passes above the report rate's Nyquist frequency folds back down into published motion,
+    // up to the sample rate's own Nyquist frequency, beyond which the on-chip filters take over
+    const double nyquist = 1 / (2 * profile.decimation * profile.time_delta);
+    const auto table = mvmt::make_gauss_table(profile.stddev, Z_CUTOFF, profile.time_delta);
+    double worst_db = -INFINITY;
+    for (double frequency = nyquist; frequency <= 1 / (2 * profile.time_delta); frequency += 0.25) {
+      std::complex<double> response = 0;
+      for (std::size_t i = 0; i < table.size(); i++) {
+        response += table[i] * std::polar(1.0, -2 * M_PI * frequency * i * profile.time_delta);
+      }
+      worst_db = std::max(worst_db, 20 * std::log10(std::abs(response)));
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "%s: %zu taps, at most %.1f dB above the %.2f Hz report Nyquist frequency",
+             profile.name, table.size(), worst_db, nyquist);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_DOUBLE(-30.0, worst_db);
+  }
+}
+
+void test_decimation_benchmark() {
+  const auto tilts = make_tilts();
+  for (const Profile &profile : PROFILES) {
+    if (profile.decimation == 1) {
+      continue;
+    }
+    double every = time_per_sample(profile, tilts, 1);
+    double decimated = time_per_sample(profile, tilts, profile.decimation);
+    char message[112];
+    snprintf(message, sizeof(message), "%s, %.1f -> %.1f Hz: every sample %.1f ns/sample, decimated %.1f ns/sample",
+             profile.name, 1 / profile.time_delta, 1 / (profile.decimation * profile.time_delta), every, decimated);
+    TEST_MESSAGE(message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_decimator_marks_every_factor_sample);
+  RUN_TEST(test_decimated_smoothing_matches_full_rate);
+  RUN_TEST(test_bell_curve_rejects_aliases);
+  RUN_TEST(test_decimation_benchmark);
+  return UNITY_END();
+}
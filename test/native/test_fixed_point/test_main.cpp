@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+#include <vector>
+
+#include "fixed_point.h"
+#include "gauss_filter.h"
+
+// Accelerometer smoothing with the main firmware's 25 ms bell curve, sampled at 225 Hz
+constexpr double STDDEV = 0.025;
+constexpr double Z_CUTOFF = 2;
+constexpr double TIME_DELTA = 5 / 1125.0;
+constexpr std::size_t TAPS = mvmt::gauss_table_length(STDDEV, Z_CUTOFF, TIME_DELTA);
+constexpr double ACCEL_FULL_SCALE = 2000; // Accelerometer range in mg
+constexpr std::size_t SAMPLES = 5000;
+
+/// @brief A noisy accelerometer trace in raw counts, as the IMU reports it: tilt sweeps plus sensor noise.
+std::vector<Eigen::Vector3i> make_trace() {
+  std::mt19937 generator(20948);
+  std::normal_distribution<double> noise(0.0, 8.0);
+  std::vector<Eigen::Vector3i> trace;
+  trace.reserve(SAMPLES);
+  const double counts_per_mg = 32768 / ACCEL_FULL_SCALE;
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    double t = i * TIME_DELTA;
+    Eigen::Vector3d mg(1900 * std::sin(0.7 * t) + noise(generator), 1200 * std::cos(1.3 * t) + noise(generator),
+                       1000 + noise(generator));
+    trace.emplace_back((mg * counts_per_mg).array().round().cast<int>().matrix());
+  }
+  return trace;
+}
+
+/// @brief Convert raw counts to a motion vector as main.cpp does: mg for floating point, or fractions of full scale
+/// for fixed point, which is what the raw counts already are.
+template <typename Scalar> Eigen::Matrix<Scalar, 3, 1> from_counts(const Eigen::Vector3i &counts) {
+  Eigen::Matrix<Scalar, 3, 1> result;
+  for (int k = 0; k < 3; k++) {
+    if constexpr (mvmt::is_fixed<Scalar>::value) {
+      result[k] = Scalar::template from_fixed<15>(counts[k]);
+    } else {
+      result[k] = static_cast<Scalar>(counts[k] * ACCEL_FULL_SCALE / 32768);
+    }
+  }
+  return result;
+}
+
+/// @brief Convert a motion value back to mg, whatever its numeric representation.
+template <typename Scalar> double to_mg(Scalar value) {
+  if constexpr (mvmt::is_fixed<Scalar>::value) {
+    return value.to_double() * ACCEL_FULL_SCALE;
+  } else {
+    return static_cast<double>(value);
+  }
+}
+
+/// @brief Run the trace through a filter with compile-time taps in the given representation and through the double
+/// reference side by side.
+/// @return The largest difference between the two outputs on any axis, in mg
+template <typename Scalar> double max_filter_error_mg() {
+  using vector_t = Eigen::Matrix<Scalar, 3, 1>;
+  static constexpr auto taps = mvmt::gauss_kernel<Scalar, TAPS>(STDDEV, Z_CUTOFF, TIME_DELTA);
+  static constexpr auto reference_taps = mvmt::gauss_kernel<double, TAPS>(STDDEV, Z_CUTOFF, TIME_DELTA);
+  mvmt::GaussianFilter<vector_t> filter(taps, vector_t::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3d> reference(reference_taps, Eigen::Vector3d::Zero());
+  double max_error = 0;
+  for (const auto &counts : make_trace()) {
+    filter.add_measurement(from_counts<Scalar>(counts));
+    reference.add_measurement(from_counts<double>(counts));
+    vector_t output = filter.get_current();
+    Eigen::Vector3d expected = reference.get_current();
+    for (int k = 0; k < 3; k++) {
+      max_error = std::max(max_error, std::abs(to_mg(output[k]) - expected[k]));
+    }
+  }
+  return max_error;
+}
+
+void report(const char *what, double error, const char *unit) {
+  char message[64];
+  snprintf(message, sizeof(message), "%s: max error %.6f %s", what, error, unit);
+  TEST_MESSAGE(message);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_float_filter_error() {
+  double error = max_filter_error_mg<float>();
+  report("float filter", error, "mg");
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.01, error);
+}
+
+void test_q15_filter_error() {
+  double error = max_filter_error_mg<mvmt::Q15>();
+  report("Q15 filter", error, "mg");
+  TEST_ASSERT_LESS_THAN_DOUBLE(1.0, error);
+}
+
+void test_q31_filter_error() {
+  double error = max_filter_error_mg<mvmt::Q31>();
+  report("Q31 filter", error, "mg");
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.001, error);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_float_filter_error);
+  RUN_TEST(test_q15_filter_error);
+  RUN_TEST(test_q31_filter_error);
+  return UNITY_END();
+}
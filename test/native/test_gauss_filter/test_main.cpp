@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <unity.h>
+#include <vector>
+
+#include "gauss_filter.h"
+
+// Accelerometer smoothing with the main firmware's 25 ms bell curve, sampled at 225 Hz
+constexpr double STDDEV = 0.025;
+constexpr double Z_CUTOFF = 2;
+constexpr double TIME_DELTA = 5 / 1125.0;
+constexpr std::size_t SAMPLES = 20000;
+
+/// @brief The std::deque GaussianFilter that the ring buffer replaced, kept as a reference for its output and speed.
+template <typename T> class DequeGaussianFilter {
+public:
+  std::deque<T> m_buffer;
+  const std::size_t m_buffer_length;
+  std::vector<double> m_gauss_table;
+  const T m_zero_element;
+
+public:
+  DequeGaussianFilter(double stddev, double z_cutoff, double time_delta, T zero_element) noexcept
+      : m_buffer_length(2 * (z_cutoff * stddev) / time_delta), m_zero_element(zero_element) {
+    double mean = stddev * z_cutoff;
+    for (std::size_t i = 0; i < m_buffer_length; i++) {
+      auto x = i * time_delta;
+      auto intermediate = exp(-0.5 * pow((x - mean) / stddev, 2));
+      m_gauss_table.push_back(intermediate / (stddev * sqrt(2 * M_PI)));
+    }
+    double accumulator = 0.0;
+    for (auto val : m_gauss_table) {
+      accumulator += val;
+    }
+    auto scale_factor = 1.0 / accumulator;
+    for (auto &val : m_gauss_table) {
+      val *= scale_factor;
+    }
+  }
+
+  void add_measurement(T measurement) noexcept {
+    if (m_buffer.size() >= m_buffer_length) {
+      m_buffer.pop_front();
+    }
+    m_buffer.push_back(measurement);
+  }
+  [[nodiscard]] T get_current() const noexcept {
+    if (m_buffer.size() < m_buffer_length) {
+      return m_buffer.back();
+    }
+    T accumulator = m_zero_element;
+    for (std::size_t i = 0; i < m_buffer_length; i++) {
+      accumulator += m_gauss_table[i] * m_buffer[i];
+    }
+    return accumulator;
+  }
+};
+
+/// @brief A noisy tilt trace in mg: slow sweeps across the accelerometer's range plus sensor noise.
+std::vector<Eigen::Vector3d> make_trace() {
+  std::mt19937 generator(20948);
+  std::normal_distribution<double> noise(0.0, 8.0);
+  std::vector<Eigen::Vector3d> trace;
+  trace.reserve(SAMPLES);
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    double t = i * TIME_DELTA;
+    trace.emplace_back(900 * std::sin(0.7 * t) + noise(generator), 600 * std::cos(1.3 * t) + noise(generator),
+                       1000 + noise(generator));
+  }
+  return trace;
+}
+
+/// @brief Time how long a filter takes to ingest a trace and produce an output after every sample.
+/// @return The mean time per sample in nanoseconds
+template <typename Filter> double time_per_sample(Filter &filter, const std::vector<Eigen::Vector3d> &trace) {
+  Eigen::Vector3d sink = Eigen::Vector3d::Zero();
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &sample : trace) {
+    filter.add_measurement(sample);
+    sink += filter.get_current();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  // Keep the outputs observable so the loop can't be optimized away
+  TEST_ASSERT_TRUE(std::isfinite(sink.sum()));
+  return std::chrono::duration<double, std::nano>(elapsed).count() / trace.size();
+}
+
+/// @brief Run a scalar filter over one axis of a trace, collecting its output after every sample.
+template <typename Filter> std::vector<double> filter_axis(Filter &filter, const std::vector<Eigen::Vector3d> &trace) {
+  std::vector<double> output;
+  output.reserve(trace.size());
+  for (const auto &sample : trace) {
+    filter.add_measurement(sample.x());
+    output.push_back(filter.get_current());
+  }
+  return output;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_ring_buffer_matches_deque_scalar() {
+  mvmt::GaussianFilter<double> ring(STDDEV, Z_CUTOFF, TIME_DELTA, 0.0);
+  DequeGaussianFilter<double> deque(STDDEV, Z_CUTOFF, TIME_DELTA, 0.0);
+  for (const auto &sample : make_trace()) {
+    ring.add_measurement(sample.x());
+    deque.add_measurement(sample.x());
+    TEST_ASSERT_TRUE(ring.get_current() == deque.get_current());
+  }
+}
+
+void test_ring_buffer_matches_deque_vector() {
+  mvmt::GaussianFilter<Eigen::Vector3d> ring(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  DequeGaussianFilter<Eigen::Vector3d> deque(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  for (const auto &sample : make_trace()) {
+    ring.add_measurement(sample);
+    deque.add_measurement(sample);
+    TEST_ASSERT_TRUE(ring.get_current() == deque.get_current());
+  }
+}
+
+void test_ring_buffer_benchmark() {
+  auto trace = make_trace();
+  mvmt::GaussianFilter<Eigen::Vector3d> ring(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  DequeGaussianFilter<Eigen::Vector3d> deque(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  double deque_ns = time_per_sample(deque, trace);
+  double ring_ns = time_per_sample(ring, trace);
+  char message[96];
+  snprintf(message, sizeof(message), "%zu taps: deque %.1f ns/sample, ring buffer %.1f ns/sample", ring.m_buffer_length,
+           deque_ns, ring_ns);
+  TEST_MESSAGE(message);
+}
+
+void test_baked_kernel_matches_runtime_table() {
+  constexpr std::size_t taps = mvmt::gauss_table_length(STDDEV, Z_CUTOFF, TIME_DELTA);
+  constexpr auto baked = mvmt::gauss_kernel<double, taps>(STDDEV, Z_CUTOFF, TIME_DELTA);
+  auto runtime = mvmt::make_gauss_table(STDDEV, Z_CUTOFF, TIME_DELTA);
+  TEST_ASSERT_EQUAL(runtime.size(), baked.size());
+  for (std::size_t i = 0; i < taps; i++) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, runtime[i], baked[i]);
+  }
+  for (double x = -10; x <= 10; x += 0.01) {
+    TEST_ASSERT_DOUBLE_WITHIN(5e-14 * std::exp(x), std::exp(x), mvmt::constexpr_exp(x));
+  }
+}
+
+/// @brief Feed one filter a trace sample by sample and another in bursts of varying size, including bursts longer than
+/// the window, and require the same output after every burst.
+template <typename Filter, typename Sample> void check_batches_match_single(Filter &single, Filter &batched,
+                                                                           const std::vector<Sample> &trace) {
+  const std::size_t burst_sizes[] = {1, 3, 7, 20, 45, 2};
+  std::size_t i = 0;
+  for (std::size_t burst = 0; i < trace.size(); burst++) {
+    std::size_t count = std::min(burst_sizes[burst % 6], trace.size() - i);
+    for (std::size_t j = 0; j < count; j++) {
+      single.add_measurement(trace[i + j]);
+    }
+    batched.add_measurements(trace.data() + i, count);
+    i += count;
+    TEST_ASSERT_TRUE(single.get_current() == batched.get_current());
+  }
+}
+
+void test_batches_match_single_samples() {
+  auto trace = make_trace();
+  mvmt::GaussianFilter<Eigen::Vector3d> fir(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3d> fir_batched(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  check_batches_match_single(fir, fir_batched, trace);
+
+  std::vector<Eigen::Vector3f> float_trace;
+  for (const auto &sample : trace) {
+    float_trace.push_back(sample.cast<float>());
+  }
+  mvmt::GaussianFilter<Eigen::Vector3f, mvmt::DspImpulse> dsp(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3f::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3f, mvmt::DspImpulse> dsp_batched(STDDEV, Z_CUTOFF, TIME_DELTA,
+                                                                      Eigen::Vector3f::Zero());
+  check_batches_match_single(dsp, dsp_batched, float_trace);
+
+  mvmt::GaussianFilter<Eigen::Vector3d, mvmt::RecursiveImpulse> iir(STDDEV, Z_CUTOFF, TIME_DELTA,
+                                                                    Eigen::Vector3d::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3d, mvmt::RecursiveImpulse> iir_batched(STDDEV, Z_CUTOFF, TIME_DELTA,
+                                                                            Eigen::Vector3d::Zero());
+  check_batches_match_single(iir, iir_batched, trace);
+}
+
+void test_recursive_tracks_fir() {
+  auto trace = make_trace();
+  mvmt::GaussianFilter<double> fir(STDDEV, Z_CUTOFF, TIME_DELTA, 0.0);
+  mvmt::GaussianFilter<double, mvmt::RecursiveImpulse> iir(STDDEV, Z_CUTOFF, TIME_DELTA, 0.0);
+  auto fir_output = filter_axis(fir, trace);
+  auto iir_output = filter_axis(iir, trace);
+  // The FIR delays the signal by z_cutoff standard deviations while the causal IIR delays it less, so compare them
+  // at the shift that lines them up best, skipping the start while the FIR buffer fills
+  const std::size_t settle = 200;
+  int best_shift = 0;
+  double best_rms = INFINITY;
+  for (int shift = 0; shift <= 20; shift++) {
+    double sum = 0;
+    for (std::size_t i = settle; i + shift < SAMPLES; i++) {
+      double error = fir_output[i + shift] - iir_output[i];
+      sum += error * error;
+    }
+    double rms = std::sqrt(sum / (SAMPLES - settle - shift));
+    if (rms < best_rms) {
+      best_rms = rms;
+      best_shift = shift;
+    }
+  }
+  char message[96];
+  snprintf(message, sizeof(message), "IIR leads FIR by %d samples, RMS difference %.3f mg on a 900 mg sweep",
+           best_shift, best_rms);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(1.0, best_rms);
+}
+
+void test_recursive_unity_gain() {
+  mvmt::GaussianFilter<double, mvmt::RecursiveImpulse> iir(STDDEV, Z_CUTOFF, TIME_DELTA, 0.0);
+  iir.add_measurement(0.0);
+  for (int i = 0; i < 500; i++) {
+    iir.add_measurement(1000.0);
+  }
+  TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1000.0, iir.get_current());
+}
+
+void test_recursive_narrow_bell_curve_is_stable() {
+  // A bell curve a fifth of a sample wide is outside the recursive fit, which used to give a negative q and a filter
+  // that rang instead of smoothing
+  mvmt::GaussianFilter<double, mvmt::RecursiveImpulse> iir(0.2 * TIME_DELTA, Z_CUTOFF, TIME_DELTA, 0.0);
+  mvmt::GaussianFilter<double, mvmt::RecursiveImpulse> half_sample(0.5 * TIME_DELTA, Z_CUTOFF, TIME_DELTA, 0.0);
+  TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, iir.m_gain);
+  TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, iir.m_a1);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, half_sample.m_a1, iir.m_a1);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, half_sample.m_a2, iir.m_a2);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, half_sample.m_a3, iir.m_a3);
+  for (const auto &sample : make_trace()) {
+    iir.add_measurement(sample.x());
+    TEST_ASSERT_TRUE(std::isfinite(iir.get_current()));
+  }
+  for (int i = 0; i < 100; i++) {
+    iir.add_measurement(500.0);
+  }
+  TEST_ASSERT_DOUBLE_WITHIN(1e-6, 500.0, iir.get_current());
+}
+
+void test_dsp_matches_fir() {
+  // Without esp-dsp on the host this runs the plain dot product, which must agree with the double-precision FIR to
+  // within single-precision rounding
+  mvmt::GaussianFilter<Eigen::Vector3d> fir(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3f, mvmt::DspImpulse> dsp(STDDEV, Z_CUTOFF, TIME_DELTA, Eigen::Vector3f::Zero());
+  double worst = 0;
+  for (const auto &sample : make_trace()) {
+    fir.add_measurement(sample);
+    dsp.add_measurement(sample.cast<float>());
+    worst = std::max(worst, (fir.get_current() - dsp.get_current().cast<double>()).cwiseAbs().maxCoeff());
+  }
+  // Samples reach about 1000 mg, where a float's rounding step is 6e-5 mg
+  TEST_ASSERT_LESS_THAN_DOUBLE(1e-3, worst);
+}
+
+void test_recursive_benchmark() {
+  auto trace = make_trace();
+  // The FIR's cost grows with the bell curve's width, while the IIR's shouldn't
+  for (double stddev : {STDDEV, 4 * STDDEV}) {
+    mvmt::GaussianFilter<Eigen::Vector3d> fir(stddev, Z_CUTOFF, TIME_DELTA, Eigen::Vector3d::Zero());
+    mvmt::GaussianFilter<Eigen::Vector3d, mvmt::RecursiveImpulse> iir(stddev, Z_CUTOFF, TIME_DELTA,
+                                                                      Eigen::Vector3d::Zero());
+    double fir_ns = time_per_sample(fir, trace);
+    double iir_ns = time_per_sample(iir, trace);
+    char message[96];
+    snprintf(message, sizeof(message), "stddev %.3f s: %zu-tap FIR %.1f ns/sample, IIR %.1f ns/sample", stddev,
+             fir.m_buffer_length, fir_ns, iir_ns);
+    TEST_MESSAGE(message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_ring_buffer_matches_deque_scalar);
+  RUN_TEST(test_ring_buffer_matches_deque_vector);
+  RUN_TEST(test_ring_buffer_benchmark);
+  RUN_TEST(test_baked_kernel_matches_runtime_table);
+  RUN_TEST(test_batches_match_single_samples);
+  RUN_TEST(test_recursive_tracks_fir);
+  RUN_TEST(test_recursive_unity_gain);
+  RUN_TEST(test_recursive_narrow_bell_curve_is_stable);
+  RUN_TEST(test_dsp_matches_fir);
+  RUN_TEST(test_recursive_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,1385 @@
+#ifndef MVMT_TEST_GESTURE_VECTORS_HPP
+#define MVMT_TEST_GESTURE_VECTORS_HPP
+
+// Generated by tools/gesture_vectors.py from include/gesture_model.h - regenerate whenever the model is retrained
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gesture_model.h"
+
+/// @brief One window of a synthetic gesture, with what the Python reference makes of it.
+struct GestureVector {
+  const char *name;
+  std::size_t gesture; // The gesture the window shows
+  std::array<mvmt::GestureFeatureExtractor::sample_t, mvmt::GESTURE_WINDOW> samples;
+  mvmt::GestureFeatureExtractor::features_t features;
+  std::array<std::int32_t, 4> scores;
+  std::size_t recognized; // The class the Python reference picks
+};
+
+const GestureVector GESTURE_VECTORS[] = {
+    {"level",
+     0,
+     {{
+      {{4, 4, 1024, -2, -3, 0}},
+      {{-3, -4, 1025, 0, 2, -3}},
+      {{0, 0, 1019, 2, 1, 7}},
+      {{1, 0, 1028, 1, 3, -1}},
+      {{1, 3, 1026, 0, -3, 1}},
+      {{0, 2, 1025, 3, 0, 1}},
+      {{2, -3, 1023, -2, 6, 0}},
+      {{2, 2, 1023, -5, 3, -1}},
+      {{2, -4, 1023, 4, 4, -4}},
+      {{-4, 0, 1026, 0, 1, -3}},
+      {{2, 3, 1023, -4, -2, 2}},
+      {{-5, 0, 1021, 0, -1, 0}},
+      {{5, 1, 1028, 0, -1, 1}},
+      {{-9, 0, 1024, -4, 1, -2}},
+      {{-7, -1, 1021, -2, 0, 4}},
+      {{0, 0, 1025, -5, 4, -3}},
+      {{1, -3, 1021, -1, 6, 2}},
+      {{-2, -1, 1021, 0, -2, 2}},
+      {{-4, -1, 1021, -2, 2, 0}},
+      {{2, 4, 1027, -4, 2, -5}},
+      {{0, 6, 1023, -1, 1, 0}},
+      {{0, -2, 1027, 3, -1, 1}},
+      {{2, 3, 1025, 2, -1, -3}},
+      {{-1, 3, 1027, 0, -2, 1}},
+      {{5, 4, 1022, 0, -4, -3}},
+      {{1, 0, 1027, 4, 3, 4}},
+      {{-2, -3, 1026, 8, 1, -3}},
+      {{1, 4, 1021, 2, -2, 4}},
+      {{2, 1, 1030, -1, -2, 6}},
+      {{-3, 7, 1024, -3, 0, 0}},
+      {{1, -1, 1027, -7, -2, -1}},
+      {{5, -6, 1023, -3, -2, 2}}}},
+     {{0, 0, 1024, 0, 0, 0, 3, 3, 22, 3, 2, 2, 3, 3, 3, 3, 2, 3, 1, 0, 0, 0, -1, 0}},
+     {{11340, -8677, -4354, -15948}},
+     0},
+    {"tilted",
+     0,
+     {{
+      {{301, -196, 958, 1, 4, 3}},
+      {{299, -197, 957, 5, 0, 0}},
+      {{301, -197, 965, 0, -1, 2}},
+      {{297, -205, 963, -1, 3, -3}},
+      {{291, -199, 960, 5, 2, 1}},
+      {{302, -201, 960, -4, 2, -2}},
+      {{299, -198, 963, -3, 6, -2}},
+      {{303, -197, 961, 1, 5, 3}},
+      {{301, -205, 958, 3, 1, -3}},
+      {{298, -201, 962, 1, 3, -2}},
+      {{303, -202, 959, 5, 0, 0}},
+      {{299, -201, 965, 4, 2, 1}},
+      {{303, -200, 961, 1, 0, 5}},
+      {{305, -196, 954, 6, 2, -1}},
+      {{300, -197, 964, 3, 0, 0}},
+      {{302, -200, 957, -2, 0, 1}},
+      {{307, -204, 961, 0, 1, 4}},
+      {{304, -200, 958, -4, 0, 4}},
+      {{299, -198, 962, 1, 3, 0}},
+      {{298, -204, 963, -1, -1, 3}},
+      {{298, -195, 962, -2, -2, 3}},
+      {{296, -202, 960, 1, 0, 1}},
+      {{299, -200, 964, 2, -1, 5}},
+      {{294, -200, 962, 3, 0, -1}},
+      {{302, -201, 961, -9, 1, -2}},
+      {{303, -198, 962, -1, 1, -1}},
+      {{301, -200, 957, 6, 2, -6}},
+      {{303, -204, 959, -2, -2, 1}},
+      {{299, -204, 960, 1, 5, -1}},
+      {{296, -201, 962, -3, -2, 2}},
+      {{300, -199, 958, -2, -1, 0}},
+      {{299, -199, 962, 2, 1, -3}}}},
+     {{300, -200, 960, 0, 1, 0, 6, 4, 34, 3, 2, 2, 3, 3, 3, 3, 2, 2, 0, -1, 0, -2, -1, 0}},
+     {{11407, -9013, -4008, -15687}},
+     0},
+    {"pointing",
+     0,
+     {{
+      {{-3, 2, 1024, 0, -3, -1}},
+      {{32, -3, 1022, -4, 0, 3}},
+      {{64, 0, 1021, 2, 6, -4}},
+      {{98, 4, 1025, 0, -6, 0}},
+      {{132, 4, 1026, -2, -2, -5}},
+      {{156, 3, 1024, -4, 4, -5}},
+      {{190, -1, 1025, 2, 1, 4}},
+      {{211, -1, 1022, -4, -2, 3}},
+      {{236, 4, 1032, 2, 2, -4}},
+      {{253, 7, 1026, 0, 1, -6}},
+      {{267, -4, 1018, 2, 3, -1}},
+      {{284, -3, 1025, 2, 5, 5}},
+      {{294, 0, 1022, -2, 2, 2}},
+      {{298, 5, 1026, 0, -1, 0}},
+      {{297, -3, 1025, -2, -1, 4}},
+      {{298, 4, 1024, 5, 1, -5}},
+      {{297, -1, 1018, 0, 0, -4}},
+      {{282, 2, 1028, 3, 4, 3}},
+      {{264, -2, 1025, -8, 2, 3}},
+      {{253, -1, 1021, 0, 0, 0}},
+      {{233, 1, 1023, 3, 1, -4}},
+      {{210, 0, 1023, 1, 2, 0}},
+      {{185, -4, 1026, -3, 3, 0}},
+      {{164, -3, 1024, -9, -1, 2}},
+      {{131, -3, 1024, 0, -2, 2}},
+      {{98, 3, 1020, -2, 4, -3}},
+      {{66, 0, 1021, -3, -2, -2}},
+      {{35, -3, 1029, -2, 3, -4}},
+      {{6, -4, 1023, 2, -2, -6}},
+      {{-31, 0, 1026, -3, -1, 0}},
+      {{-67, 0, 1022, 1, 0, 0}},
+      {{-102, 0, 1023, -3, -2, -4}}}},
+     {{160, 0, 1023, 0, 0, 0, 118, 2, 41, 3, 2, 3, 22, 3, 3, 4, 3, 3, -67, -2, 0, -1, 0, 0}},
+     {{9519, -8318, -3498, -14682}},
+     0},
+    {"flick left",
+     1,
+     {{
+      {{1, 2, 1026, -2, 5, 3}},
+      {{-3, 0, 1019, 0, 2, 4}},
+      {{-1, -5, 1023, 4, 0, 4}},
+      {{2, 5, 1026, -2, 1, 8}},
+      {{-2, -6, 1030, 1, -2, -2}},
+      {{-5, 2, 1024, -2, -1, -1}},
+      {{3, -1, 1028, -3, -2, -1}},
+      {{-2, 0, 1027, 4, -3, 4}},
+      {{0, 5, 1023, -3, 2, 2}},
+      {{-1, 0, 1024, 1, -5, -4}},
+      {{0, 1, 1022, -5, 4, -1}},
+      {{-3, 5, 1027, 3, 3, 2}},
+      {{-3, 0, 1025, 2, 1, -3}},
+      {{-2, -1, 1023, -3, -5, -4}},
+      {{1, 0, 1026, -6, -1, 3}},
+      {{-6, -3, 1019, 4, 0, -2}},
+      {{0, 0, 1027, 4, 3, 1}},
+      {{2, 2, 1027, -6, 1, -10}},
+      {{0, -1, 1024, 1, 1, -764}},
+      {{-3, -4, 1022, -5, -2, -2504}},
+      {{-5, -6, 1023, -2, 7, -4096}},
+      {{-2, -1, 1021, -2, -1, -4096}},
+      {{-2, 2, 1026, 6, -4, -4096}},
+      {{-1, -5, 1023, -5, 0, -4096}},
+      {{4, 5, 1028, -5, 1, -4096}},
+      {{1, -3, 1018, 6, 4, -4096}},
+      {{-1, 1, 1020, 3, 0, -2502}},
+      {{-1, 0, 1024, -1, 3, -763}},
+      {{0, -3, 1028, 4, 2, -15}},
+      {{-1, 3, 1024, 4, -1, 2}},
+      {{2, -7, 1023, -1, -2, -3}},
+      {{5, 0, 1026, -4, -6, -1}}}},
+     {{0, 0, 1024, 0, 0, -972, 2, 3, 22, 3, 2, 1621, 2, 4, 3, 4, 3, 266, 1, -1, 0, 0, 0, -1946}},
+     {{667, 2935, -4495, -5324}},
+     1},
+    {"slow flick left",
+     1,
+     {{
+      {{1, -2, 1026, 2, -1, 0}},
+      {{-2, 3, 1029, 1, -2, -2}},
+      {{-1, 3, 1022, 4, -4, 0}},
+      {{4, 5, 1023, 2, 8, 4}},
+      {{-7, 1, 1031, -3, 3, -6}},
+      {{5, -3, 1026, 3, -8, -4}},
+      {{1, -5, 1024, -3, 4, -2}},
+      {{-3, 2, 1028, 0, 1, 1}},
+      {{-1, -4, 1026, -1, -4, 3}},
+      {{1, 0, 1022, -1, 2, 1}},
+      {{-2, -3, 1025, 1, 3, -3}},
+      {{3, 5, 1027, 0, 3, -4}},
+      {{-1, 6, 1019, -3, 2, -46}},
+      {{-2, -3, 1029, -2, -1, -240}},
+      {{2, 0, 1025, 5, 0, -565}},
+      {{-3, 0, 1028, -4, -1, -1000}},
+      {{2, -3, 1025, 2, 0, -1516}},
+      {{2, 2, 1028, -3, 4, -2070}},
+      {{-3, -2, 1020, -1, 3, -2625}},
+      {{-4, 2, 1023, 2, -4, -3119}},
+      {{-8, -3, 1026, 4, 5, -3532}},
+      {{-3, -1, 1018, 4, 4, -3830}},
+      {{5, -4, 1026, -2, -5, -3979}},
+      {{-3, 4, 1021, 0, -1, -3980}},
+      {{-2, 2, 1026, 0, 0, -3821}},
+      {{-2, -1, 1026, 0, -5, -3533}},
+      {{-1, -3, 1025, -3, -1, -3122}},
+      {{5, -1, 1025, 1, 2, -2618}},
+      {{2, 0, 1017, 1, -4, -2067}},
+      {{1, -1, 1016, -6, -4, -1517}},
+      {{-4, 6, 1025, 0, -3, -1001}},
+      {{-1, -1, 1024, 2, -5, -561}}}},
+     {{0, 0, 1024, 0, 0, -1398, 3, 3, 29, 2, 3, 1504, 3, 3, 4, 3, 3, 239, 0, 0, -2, 0, -1, -2564}},
+     {{826, 2471, -4198, -5461}},
+     1},
+    {"twist",
+     2,
+     {{
+      {{3, -4, 1023, -1, -3, 3}},
+      {{-1, 3, 1025, -1, 987, -1}},
+      {{-5, 4, 1025, 3, 1858, 3}},
+      {{2, 0, 1018, 0, 2531, -1}},
+      {{0, -3, 1024, 0, 2925, 0}},
+      {{7, -4, 1024, 4, 2979, 2}},
+      {{1, -2, 1023, 5, 2713, 1}},
+      {{1, 4, 1018, -4, 2139, -1}},
+      {{2, 2, 1023, 5, 1334, 2}},
+      {{-2, 2, 1022, 3, 379, 6}},
+      {{-1, -3, 1026, 1, -625, -4}},
+      {{2, -6, 1023, 3, -1555, 1}},
+      {{1, 2, 1027, 2, -2313, -4}},
+      {{-1, -2, 1025, 4, -2809, -2}},
+      {{1, 0, 1023, 4, -2997, 1}},
+      {{-4, -8, 1022, 3, -2854, 0}},
+      {{-1, 1, 1024, 5, -2390, -1}},
+      {{4, 2, 1026, 2, -1660, 1}},
+      {{2, 0, 1018, 4, -748, -2}},
+      {{-1, -2, 1021, 0, 254, -1}},
+      {{1, -4, 1026, -3, 1222, -2}},
+      {{-2, -4, 1020, -1, 2051, -1}},
+      {{3, -3, 1023, 0, 2657, 0}},
+      {{1, 3, 1022, -1, 2967, 4}},
+      {{-3, 1, 1026, 2, 2945, -3}},
+      {{-6, -2, 1023, -4, 2601, 0}},
+      {{-1, -2, 1025, -1, 1962, -1}},
+      {{3, -5, 1021, 5, 1108, 5}},
+      {{-2, 2, 1027, 3, 125, 4}},
+      {{1, -4, 1031, 0, -863, -2}},
+      {{-3, 3, 1026, -2, -1763, -4}},
+      {{-6, 3, 1021, 2, -2460, 1}}}},
+     {{0, 0, 1023, 1, 396, 0, 2, 3, 31, 2, 2026, 2, 3, 3, 3, 2, 656, 3, -1, 0, 0, -1, 207, 0}},
+     {{-1315, -3144, 2187, -9725}},
+     2},
+    {"fast twist",
+     2,
+     {{
+      {{5, 1, 1025, 0, 1, 1}},
+      {{-3, 0, 1023, 9, 1300, -2}},
+      {{2, -5, 1024, 5, 2338, 4}},
+      {{-1, 1, 1025, -7, 2918, 6}},
+      {{-2, 4, 1029, 0, 2933, 1}},
+      {{-2, 2, 1025, -3, 2363, -4}},
+      {{-1, 0, 1021, -6, 1336, 4}},
+      {{-3, 0, 1022, -8, 48, 1}},
+      {{-4, 4, 1026, 4, -1256, 2}},
+      {{4, -1, 1025, -3, -2315, 1}},
+      {{1, -5, 1025, 3, -2915, -1}},
+      {{5, -3, 1026, 2, -2938, 0}},
+      {{2, 1, 1024, -4, -2389, -2}},
+      {{4, 7, 1027, -6, -1368, 0}},
+      {{-3, -4, 1027, -2, -84, 0}},
+      {{3, -8, 1028, -2, 1219, 2}},
+      {{1, -7, 1026, 0, 2282, -2}},
+      {{-5, 2, 1028, -2, 2899, -4}},
+      {{-2, -3, 1024, 5, 2950, 3}},
+      {{-3, 3, 1022, -3, 2417, 0}},
+      {{7, 1, 1023, 2, 1405, 2}},
+      {{5, 0, 1022, 3, 122, 1}},
+      {{-2, 1, 1022, 2, -1180, 5}},
+      {{-1, 1, 1019, -2, -2256, -4}},
+      {{0, -3, 1025, 2, -2891, 2}},
+      {{-2, 0, 1026, 2, -2953, 5}},
+      {{-2, 0, 1019, 3, -2443, -2}},
+      {{-2, 1, 1023, -1, -1445, -1}},
+      {{0, -3, 1022, -4, -165, 3}},
+      {{2, 1, 1022, 2, 1139, -8}},
+      {{-4, 4, 1025, 5, 2227, 3}},
+      {{5, 3, 1025, 3, 2877, 5}}}},
+     {{0, 0, 1024, 0, 193, 0, 3, 3, 21, 3, 2090, 3, 3, 3, 2, 4, 852, 3, 0, 0, -1, 2, 237, 0}},
+     {{-1423, -2752, 1759, -8983}},
+     2},
+    {"shake",
+     3,
+     {{
+      {{-3, -2, 1697, 270, 118, 2}},
+      {{-2, 498, 1806, 215, -149, 497}},
+      {{-2, 930, 1821, 140, -399, 936}},
+      {{-1, 1261, 1745, 45, -605, 1270}},
+      {{0, 1461, 1600, -58, -745, 1457}},
+      {{-4, 1492, 1383, -148, -803, 1486}},
+      {{-6, 1357, 1134, -230, -767, 1358}},
+      {{5, 1075, 864, -277, -646, 1072}},
+      {{1, 672, 607, -301, -452, 666}},
+      {{0, 187, 407, -285, -207, 187}},
+      {{1, -309, 274, -241, 50, -307}},
+      {{5, -778, 230, -166, 308, -776}},
+      {{1, -1154, 264, -79, 542, -1155}},
+      {{6, -1406, 377, 28, 705, -1411}},
+      {{-2, -1502, 581, 117, 793, -1501}},
+      {{3, -1428, 817, 205, 787, -1425}},
+      {{-5, -1198, 1086, 270, 700, -1200}},
+      {{-9, -825, 1347, 293, 535, -828}},
+      {{6, -372, 1567, 298, 302, -374}},
+      {{-3, 124, 1727, 257, 43, 127}},
+      {{0, 610, 1816, 201, -218, 616}},
+      {{1, 1028, 1809, 117, -456, 1018}},
+      {{2, 1326, 1720, 16, -653, 1325}},
+      {{-1, 1492, 1546, -85, -768, 1483}},
+      {{3, 1480, 1322, -173, -800, 1478}},
+      {{0, 1301, 1061, -241, -743, 1297}},
+      {{6, 974, 797, -289, -606, 986}},
+      {{1, 551, 555, -299, -397, 551}},
+      {{-2, 67, 370, -278, -150, 60}},
+      {{2, -436, 257, -225, 122, -433}},
+      {{-1, -882, 225, -145, 381, -879}},
+      {{-4, -1225, 285, -55, 586, -1232}}}},
+     {{0, 199, 1034, -34, -112, 198, 3, 1013, 590, 206, 534, 1013, 4, 329, 159, 64, 177, 328, 0, 103, 117, 26, -40,
+        102}},
+     {{6917, -25141, -322, 15729}},
+     3},
+    {"hard shake",
+     3,
+     {{
+      {{1, 252, 3752, 46, -2265, -2876}},
+      {{1353, 259, 1101, -248, -2757, -494}},
+      {{1179, -28, -1643, -257, -147, 2443}},
+      {{-313, -283, -1382, 19, 2628, 2637}},
+      {{-1454, -218, 1572, 275, 2455, -131}},
+      {{-965, 87, 3919, 225, -480, -2756}},
+      {{616, 295, 3005, -84, -2875, -2282}},
+      {{1497, 167, -126, -298, -2045, 751}},
+      {{703, -150, -1976, -179, 1082, 2938}},
+      {{-883, -296, -446, 141, 2991, 1826}},
+      {{-1482, -114, 2731, 298, 1535, -1340}},
+      {{-417, 200, 3987, 127, -1637, -3000}},
+      {{1115, 287, 1924, -192, -2981, -1295}},
+      {{1392, 54, -1154, -290, -963, 1866}},
+      {{108, -237, -1780, -64, 2129, 2937}},
+      {{-1300, -268, 742, 233, 2831, 700}},
+      {{-1244, 10, 3581, 269, 357, -2315}},
+      {{211, 279, 3548, -2, -2523, -2732}},
+      {{1425, 233, 685, -262, -2567, -86}},
+      {{1047, -69, -1807, -233, 271, 2660}},
+      {{-516, -290, -1110, 59, 2802, 2416}},
+      {{-1494, -189, 1978, 290, 2190, -545}},
+      {{-792, 130, 3993, 193, -886, -2896}},
+      {{797, 300, 2674, -120, -2962, -1987}},
+      {{1490, 135, -495, -304, -1713, 1147}},
+      {{518, -180, -1966, -142, 1467, 2995}},
+      {{-1042, -294, -69, 176, 2996, 1481}},
+      {{-1429, -77, 3055, 298, 1165, -1700}},
+      {{-212, 226, 3898, 86, -1973, -2967}},
+      {{1240, 272, 1515, -221, -2894, -904}},
+      {{1301, 8, -1418, -274, -562, 2176}},
+      {{-105, -260, -1613, -23, 2403, 2806}}}},
+     {{73, 7, 958, -14, -91, 46, 1041, 213, 2140, 207, 2126, 2148, 1010, 201, 2015, 201, 2022, 2023, 2, 14, 138, 2,
+        -120, -148}},
+     {{2011, -25530, 2131, 17967}},
+     3}};
+
+/// @brief Raw IMU counts of a synthetic gesture at a sensor profile's sample rate, with the window they decimate to and
+/// what the Python reference makes of it.
+struct GestureRawVector {
+  const char *name;
+  std::size_t decimation; // Raw samples averaged into each decimated sample
+  int gyro_shift;         // Bits the gyroscope is scaled up by, to read as at +/-250 dps
+  const mvmt::GestureFeatureExtractor::sample_t *raw;
+  std::size_t raw_count;
+  std::size_t gesture; // The gesture the window shows
+  std::array<mvmt::GestureFeatureExtractor::sample_t, mvmt::GESTURE_WINDOW> samples;
+  mvmt::GestureFeatureExtractor::features_t features;
+  std::size_t recognized; // The class the Python reference picks
+};
+
+const mvmt::GestureFeatureExtractor::sample_t RAW_0[] = {
+    {{24, 22, 16383, -1, 3, -1}},
+    {{7, 39, 16383, 2, 0, 0}},
+    {{0, 32, 16353, 1, 2, -2}},
+    {{-72, -64, 16346, 1, 0, 3}},
+    {{76, -74, 16365, 0, 2, 1}},
+    {{45, -39, 16481, -2, 0, -1}},
+    {{-43, 12, 16341, 1, 1, 0}},
+    {{31, 54, 16436, -2, 1, 1}},
+    {{-18, -19, 16442, 1, 0, 2}},
+    {{45, 83, 16365, 1, -3, -1}},
+    {{80, -46, 16377, -1, 1, 2}},
+    {{77, -7, 16400, 1, 2, 0}},
+    {{65, -69, 16397, -2, -1, -1}},
+    {{85, 80, 16421, 0, -3, -3}},
+    {{9, 35, 16409, -1, -1, 1}},
+    {{109, 35, 16382, 0, 1, 0}},
+    {{-69, 74, 16406, 1, -1, 2}},
+    {{49, -35, 16433, -1, -3, 1}},
+    {{-48, -27, 16339, 0, -1, 0}},
+    {{23, 78, 16406, 1, 1, 1}},
+    {{43, 14, 16328, -1, 0, 0}},
+    {{-20, -25, 16350, 2, 1, -2}},
+    {{9, -1, 16362, 2, 0, 0}},
+    {{-41, 46, 16396, 0, -1, 2}},
+    {{-148, -67, 16304, -2, -2, -1}},
+    {{-16, 9, 16449, 1, 0, 0}},
+    {{18, 39, 16349, 3, 0, 1}},
+    {{-117, 9, 16365, 2, 2, 0}},
+    {{30, -15, 16341, 2, -2, -1}},
+    {{-56, -45, 16364, 1, -1, 1}},
+    {{-89, -40, 16342, 1, 2, -3}},
+    {{3, 78, 16385, 2, 2, 0}},
+    {{-67, -32, 16458, -1, -2, -1}},
+    {{61, 5, 16311, -1, 1, 2}},
+    {{73, 25, 16406, -1, -1, -2}},
+    {{-7, 19, 16386, -1, 1, 1}},
+    {{59, -103, 16268, -2, 1, 2}},
+    {{35, 2, 16396, 0, -1, -1}},
+    {{152, -12, 16411, 1, 1, 0}},
+    {{45, 96, 16353, -1, -1, -1}},
+    {{-59, 16, 16416, 2, 2, -1}},
+    {{9, -38, 16387, 0, 1, 0}},
+    {{-51, 48, 16378, -2, -3, 1}},
+    {{-85, 32, 16456, 1, 1, 1}},
+    {{-29, 11, 16295, 1, 1, 0}},
+    {{52, -8, 16302, 2, 0, -1}},
+    {{-25, -17, 16394, -2, 0, -1}},
+    {{31, -15, 16414, -1, 1, 0}},
+    {{51, 18, 16433, -1, -1, 0}},
+    {{-49, -13, 16444, -2, -1, 0}},
+    {{78, 102, 16358, -1, 0, -1}},
+    {{-94, 28, 16402, 0, 1, 0}},
+    {{-30, 30, 16382, 0, -2, 0}},
+    {{-2, -41, 16348, -1, 0, -1}},
+    {{-52, 3, 16326, 0, -1, 0}},
+    {{53, -106, 16320, -1, 0, -1}},
+    {{-45, -29, 16336, 0, -1, 0}},
+    {{2, 32, 16354, -1, 1, -3}},
+    {{3, -43, 16425, 0, -1, 2}},
+    {{-26, -42, 16405, -3, 0, 1}},
+    {{-59, 45, 16370, -1, -2, 2}},
+    {{63, -16, 16401, -3, 0, 1}},
+    {{-36, -30, 16374, -1, -2, 1}},
+    {{41, 27, 16418, 2, 0, -4}},
+    {{1, -27, 16329, 1, -2, -2}},
+    {{113, -19, 16391, 1, 1, 0}},
+    {{24, -5, 16362, 0, 1, 1}},
+    {{20, -72, 16373, 1, -1, 1}},
+    {{5, 56, 16276, 0, 2, 1}},
+    {{-24, -11, 16367, 1, 1, -1}},
+    {{50, 22, 16285, -1, 0, -1}},
+    {{4, -3, 16379, 0, 0, -1}},
+    {{26, -84, 16387, -1, -1, 0}},
+    {{-30, -151, 16315, 0, 0, -1}},
+    {{-31, 32, 16384, -2, -1, 1}},
+    {{5, 17, 16385, 0, -1, -1}},
+    {{-46, -42, 16467, 1, 0, 0}},
+    {{-76, 36, 16302, 2, -1, -2}},
+    {{69, -47, 16371, 0, -2, 1}},
+    {{-63, -9, 16330, 2, 0, 2}},
+    {{-25, 11, 16409, 0, 0, 2}},
+    {{18, 3, 16423, -4, -2, 1}},
+    {{-17, -13, 16314, -1, 2, -1}},
+    {{-47, -14, 16434, -1, -2, 0}},
+    {{-17, 7, 16303, -2, 0, 0}},
+    {{82, 64, 16438, 1, 2, 1}},
+    {{30, -19, 16361, 2, -2, -1}},
+    {{-11, 9, 16352, -1, -1, -1}},
+    {{-19, 158, 16328, 4, -2, 0}},
+    {{-4, 29, 16370, -2, -1, 0}},
+    {{-70, -4, 16388, -2, -2, 1}},
+    {{-45, -31, 16356, -1, 1, 0}},
+    {{100, -17, 16401, -1, 1, -2}},
+    {{-39, -10, 16515, 3, 3, 0}},
+    {{-73, 26, 16435, -1, 3, 3}},
+    {{-80, -19, 16371, 0, 0, 0}},
+    {{-12, 122, 16362, -2, 2, 1}},
+    {{-54, -42, 16342, -3, -2, 1}},
+    {{-63, -12, 16371, -1, 1, 0}},
+    {{59, 16, 16355, 2, 0, 1}},
+    {{14, -16, 16340, 2, -1, 0}},
+    {{42, 47, 16385, 3, 0, 3}},
+    {{65, 9, 16373, 2, -3, 1}},
+    {{32, 75, 16451, 0, 1, -1}},
+    {{26, -37, 16319, 3, 3, 0}},
+    {{15, 114, 16320, 2, 0, 1}},
+    {{-4, 73, 16442, 0, 2, 1}},
+    {{67, -50, 16426, 0, 0, -2}},
+    {{103, -3, 16406, -2, 0, 0}},
+    {{6, -53, 16401, -1, 1, -2}},
+    {{56, -49, 16331, 1, 1, 1}},
+    {{-27, -14, 16341, 2, -3, -2}},
+    {{-56, 25, 16313, 1, -3, -3}},
+    {{16, 19, 16366, 2, -1, -1}},
+    {{-9, 64, 16376, 3, 2, 2}},
+    {{43, 62, 16407, -4, 0, 0}},
+    {{-56, -89, 16391, -2, 0, -1}},
+    {{16, -46, 16395, 0, -1, 0}},
+    {{13, -127, 16292, 0, 0, 0}},
+    {{16, -47, 16446, 1, 1, 0}},
+    {{-34, -28, 16402, 0, 1, 0}},
+    {{-21, 56, 16316, -2, 1, -1}},
+    {{-68, -71, 16384, 2, 2, 0}},
+    {{-12, -40, 16474, 0, -1, 1}},
+    {{55, 2, 16443, -2, 1, 1}},
+    {{20, 32, 16392, 1, -3, -1}},
+    {{41, -53, 16342, 3, 0, 0}},
+    {{18, 83, 16371, -1, 0, 2}},
+    {{-85, -6, 16365, 0, 1, 0}},
+    {{-75, -11, 16378, 0, 2, 0}},
+    {{-30, -8, 16385, 1, -3, -2}},
+    {{-4, 44, 16381, 0, 3, 0}},
+    {{14, -2, 16431, 1, 0, 1}},
+    {{21, -23, 16420, 3, -2, -2}},
+    {{-5, -10, 16395, 0, 0, 2}},
+    {{61, -100, 16410, 0, 1, 0}},
+    {{17, -10, 16353, 0, 1, 0}},
+    {{-3, 60, 16425, -1, -1, 0}},
+    {{23, 50, 16303, 2, 0, 0}},
+    {{40, 13, 16393, 1, 2, -2}},
+    {{-75, -50, 16397, 0, 0, -1}},
+    {{-40, 25, 16382, 0, 1, 2}},
+    {{101, -28, 16446, 0, 1, 2}},
+    {{-28, -6, 16431, 1, 3, 1}},
+    {{6, -5, 16413, -3, 2, 0}},
+    {{-29, 5, 16410, -2, 1, -3}},
+    {{69, -13, 16396, 0, -1, 1}},
+    {{-46, -4, 16410, -2, 1, -1}},
+    {{42, -16, 16446, 0, -1, 1}},
+    {{57, 45, 16314, -2, 1, 1}},
+    {{-15, -9, 16392, -3, -2, -2}},
+    {{50, -18, 16284, 0, -1, -1}},
+    {{-69, -44, 16398, -1, 1, 2}},
+    {{-16, -76, 16337, 0, 1, 0}},
+    {{-2, 10, 16442, 1, -1, -1}},
+    {{-2, -29, 16337, 2, 0, -2}},
+    {{19, -51, 16337, -2, -2, -1}},
+    {{12, -5, 16397, 0, -1, 2}},
+    {{-54, -49, 16481, 0, 0, 4}},
+    {{-52, 76, 16382, 0, -1, 0}},
+    {{35, -1, 16361, 1, 2, 0}},
+    {{-21, -20, 16402, -1, 2, -1}},
+    {{51, -9, 16419, -2, 0, -2}},
+    {{-38, -3, 16327, 3, 2, 1}},
+    {{0, -29, 16301, 1, -2, 0}},
+    {{-29, -1, 16464, 0, 0, 1}},
+    {{-26, -94, 16347, 0, -1, 1}},
+    {{57, -49, 16385, 0, -1, -1}},
+    {{20, -20, 16470, 0, 0, 0}},
+    {{10, -21, 16411, 1, 0, 0}},
+    {{-67, -21, 16388, -1, 2, -4}},
+    {{-2, -33, 16365, 0, 2, -18}},
+    {{44, -19, 16461, 1, -1, -32}},
+    {{-68, 33, 16377, -2, 0, -55}},
+    {{116, 40, 16402, 0, -3, -88}},
+    {{-113, -59, 16431, 2, 0, -121}},
+    {{33, 111, 16391, 2, 2, -163}},
+    {{6, -40, 16399, -1, -1, -208}},
+    {{-4, -12, 16425, 1, 2, -258}},
+    {{-60, 22, 16299, 1, 3, -320}},
+    {{58, 32, 16402, -3, -2, -383}},
+    {{3, 5, 16422, 0, 0, -452}},
+    {{-37, -10, 16490, -1, 0, -522}},
+    {{38, 30, 16388, 2, -1, -599}},
+    {{74, 12, 16358, -1, 0, -686}},
+    {{61, -41, 16325, 1, 0, -770}},
+    {{63, -56, 16356, -2, 3, -858}},
+    {{-69, 24, 16355, -1, 0, -955}},
+    {{9, 0, 16455, -1, -2, -1050}},
+    {{-28, 40, 16491, 1, 1, -1150}},
+    {{-68, -58, 16415, 2, 0, -1253}},
+    {{37, -5, 16348, -2, -3, -1353}},
+    {{-23, 14, 16407, 1, 3, -1462}},
+    {{57, -42, 16315, 0, -3, -1573}},
+    {{-37, 30, 16373, -3, 0, -1681}},
+    {{-25, -28, 16378, 1, 1, -1791}},
+    {{-40, -75, 16475, 2, -3, -1902}},
+    {{19, 5, 16393, -1, 2, -2013}},
+    {{48, 14, 16393, -1, 2, -2128}},
+    {{65, -10, 16396, -1, -3, -2238}},
+    {{20, -22, 16407, -1, -3, -2348}},
+    {{-21, -37, 16453, -3, 0, -2457}},
+    {{63, 6, 16401, 0, 0, -2565}},
+    {{-8, 40, 16490, -1, 0, -2673}},
+    {{92, 83, 16395, 2, 0, -2777}},
+    {{85, -75, 16334, 2, 1, -2876}},
+    {{-18, -34, 16327, 2, 1, -2972}},
+    {{22, 26, 16358, -1, 1, -3073}},
+    {{50, 51, 16324, 1, 0, -3164}},
+    {{-16, 55, 16394, 1, 1, -3254}},
+    {{-56, 80, 16467, 0, 2, -3336}},
+    {{73, 46, 16379, 1, -1, -3419}},
+    {{-45, -77, 16341, -2, 1, -3495}},
+    {{22, -36, 16383, -2, 1, -3567}},
+    {{92, -48, 16377, 0, 4, -3634}},
+    {{22, -71, 16378, 3, 2, -3695}},
+    {{-17, -43, 16396, -1, 3, -3753}},
+    {{-23, 36, 16396, -1, -2, -3805}},
+    {{76, -27, 16377, 1, 2, -3848}},
+    {{19, -28, 16340, 0, 0, -3888}},
+    {{-97, -66, 16422, 2, 0, -3924}},
+    {{29, -41, 16371, 0, 1, -3949}},
+    {{30, -46, 16435, -1, -2, -3971}},
+    {{91, -49, 16366, -1, -1, -3986}},
+    {{39, 9, 16393, -1, -1, -3998}},
+    {{29, 32, 16367, 1, -1, -3997}},
+    {{-50, -25, 16380, 1, 0, -3998}},
+    {{28, 38, 16331, -3, 1, -3989}},
+    {{49, 87, 16446, 0, 1, -3972}},
+    {{-41, -6, 16364, 0, -2, -3952}},
+    {{5, 5, 16386, 1, -2, -3922}},
+    {{-12, -2, 16436, 0, 1, -3886}},
+    {{-2, -87, 16360, -1, 0, -3850}},
+    {{7, 12, 16292, 2, -1, -3806}},
+    {{-37, 35, 16534, -3, -1, -3751}},
+    {{-32, 3, 16363, 0, 0, -3698}},
+    {{-47, -69, 16395, 4, 2, -3634}},
+    {{62, 30, 16369, -1, 0, -3569}},
+    {{-1, 20, 16325, -2, 0, -3497}},
+    {{-5, 15, 16401, 1, 0, -3419}},
+    {{-5, 4, 16380, 0, 0, -3338}},
+    {{39, 63, 16459, 1, -1, -3255}},
+    {{-75, -15, 16393, 2, 0, -3164}},
+    {{-57, 34, 16474, -1, 3, -3071}},
+    {{-39, 30, 16395, 1, -2, -2975}},
+    {{42, -57, 16407, 2, 0, -2878}},
+    {{-10, 36, 16411, 0, -1, -2776}},
+    {{-9, -56, 16402, 3, 0, -2671}},
+    {{6, 29, 16371, 1, -1, -2566}},
+    {{-28, 24, 16353, -1, 0, -2460}},
+    {{-22, -112, 16354, 3, -2, -2346}},
+    {{-29, -27, 16366, 3, -1, -2237}},
+    {{-23, -13, 16419, 0, 0, -2127}},
+    {{9, -10, 16382, 0, -1, -2016}},
+    {{19, -86, 16426, -1, -1, -1901}},
+    {{-31, 3, 16340, 1, 0, -1791}},
+    {{-11, -74, 16437, -1, 0, -1681}},
+    {{11, -11, 16366, 0, 0, -1568}},
+    {{-54, 49, 16388, 1, -1, -1461}},
+    {{35, -90, 16301, 2, -1, -1356}},
+    {{-72, -2, 16386, -1, 2, -1251}},
+    {{39, 1, 16392, 0, -1, -1146}},
+    {{53, 55, 16352, -1, 0, -1049}},
+    {{28, 76, 16357, -1, -2, -950}},
+    {{8, 16, 16352, 0, 0, -860}},
+    {{25, 61, 16443, 0, 5, -770}},
+    {{1, -63, 16370, 0, -1, -683}},
+    {{-47, -21, 16325, -1, -3, -602}},
+    {{-23, -8, 16443, -2, -1, -522}},
+    {{-44, -18, 16302, -5, 3, -449}},
+    {{96, -6, 16315, 1, -1, -382}},
+    {{18, 27, 16345, 0, 1, -317}},
+    {{-18, 89, 16413, 1, -1, -261}},
+    {{29, -48, 16414, 0, 0, -210}},
+    {{-10, 31, 16465, 0, -1, -161}},
+    {{45, 35, 16376, -4, 0, -121}},
+    {{-55, 1, 16336, 0, 2, -86}},
+    {{-113, 48, 16378, 0, -3, -59}},
+    {{-18, -26, 16391, 0, 0, -34}},
+    {{16, -25, 16406, 1, -2, -16}},
+    {{-18, -1, 16471, -1, 0, -5}},
+    {{-104, 66, 16412, 0, 1, 4}},
+    {{-39, 63, 16465, -1, 1, -2}},
+    {{12, -33, 16411, -1, 2, 2}},
+    {{81, -4, 16369, 0, -1, 0}},
+    {{-48, -12, 16422, 1, 1, -2}},
+    {{72, 87, 16425, -1, 1, 0}},
+    {{-75, 54, 16425, 1, 1, 0}},
+    {{-56, 72, 16369, 0, 1, -2}},
+    {{-10, 28, 16373, -4, 0, 1}},
+    {{-62, 109, 16393, 0, 1, 2}},
+    {{13, -3, 16401, -2, 3, -2}},
+    {{-7, -36, 16390, 0, 2, 0}},
+    {{-12, 99, 16337, 0, -1, 1}},
+    {{1, 58, 16349, 0, 1, 0}},
+    {{15, -74, 16408, 0, 3, -1}},
+    {{-70, 97, 16476, 0, -3, -1}},
+    {{14, 21, 16432, 2, 1, 0}},
+    {{65, 76, 16402, -1, 1, 0}},
+    {{-1, 6, 16440, 2, 2, 1}},
+    {{-16, -74, 16375, 1, -1, 1}},
+    {{-38, 13, 16256, 1, 1, 0}},
+    {{33, -46, 16388, -1, 0, 0}},
+    {{8, -35, 16363, -3, 0, -4}},
+    {{16, 92, 16361, -1, 0, 1}},
+    {{35, -25, 16370, 1, 1, -2}},
+    {{24, 82, 16301, -1, 0, -2}},
+    {{-63, 80, 16393, 1, 1, -2}},
+    {{59, -30, 16435, 0, 2, 1}},
+    {{-1, 48, 16355, 1, -2, 0}},
+    {{92, 44, 16339, 2, 0, 1}},
+    {{-16, 30, 16360, 2, 0, -1}},
+    {{-18, -64, 16417, 2, 2, 1}},
+    {{-6, 64, 16453, -1, -2, -1}},
+    {{1, 54, 16437, 1, 2, 0}},
+    {{-4, -104, 16361, 0, 2, 0}},
+    {{-16, 8, 16368, -3, -1, 0}},
+    {{-8, -30, 16364, 1, -2, 0}},
+    {{-27, -10, 16387, 1, -4, 0}},
+    {{-53, -79, 16393, 0, -1, 0}}};
+const mvmt::GestureFeatureExtractor::sample_t RAW_1[] = {
+    {{-39, 68, 16466, 2, -2, 1}},
+    {{17, 5, 16378, 0, 49, -1}},
+    {{-37, 114, 16411, -1, 100, 1}},
+    {{87, 81, 16340, -2, 150, 0}},
+    {{-25, -26, 16483, -2, 201, 0}},
+    {{-27, 92, 16324, 0, 250, -1}},
+    {{-20, 5, 16508, 1, 299, -2}},
+    {{11, 39, 16518, -2, 347, -3}},
+    {{-73, 57, 16379, -1, 398, 0}},
+    {{-6, 56, 16425, -1, 447, 2}},
+    {{-12, -21, 16366, -1, 490, 2}},
+    {{65, -115, 16370, -1, 540, 1}},
+    {{52, 24, 16418, 2, 587, 2}},
+    {{43, -32, 16420, -1, 635, 2}},
+    {{-65, 29, 16339, -1, 677, 1}},
+    {{32, -2, 16286, 1, 724, -4}},
+    {{-28, -27, 16396, 0, 768, -1}},
+    {{-42, -93, 16296, 0, 810, -2}},
+    {{31, -19, 16426, 2, 852, -1}},
+    {{50, 10, 16387, 1, 893, 2}},
+    {{-62, 59, 16396, 2, 932, 1}},
+    {{47, 64, 16370, 2, 970, -2}},
+    {{-38, -62, 16452, 1, 1006, 0}},
+    {{13, 11, 16359, -1, 1046, 0}},
+    {{-42, 13, 16353, 0, 1082, 0}},
+    {{122, -67, 16337, 2, 1115, 0}},
+    {{46, -9, 16338, 2, 1148, 0}},
+    {{9, -2, 16344, -1, 1177, 1}},
+    {{4, -10, 16314, -2, 1209, 0}},
+    {{-8, -4, 16342, 1, 1239, 2}},
+    {{25, -48, 16354, 0, 1268, 0}},
+    {{0, 68, 16427, 1, 1290, 0}},
+    {{95, 32, 16445, 3, 1319, -3}},
+    {{18, -9, 16342, 2, 1340, 2}},
+    {{22, -24, 16344, 3, 1362, 1}},
+    {{-1, -40, 16369, 0, 1380, -1}},
+    {{-43, 16, 16391, -2, 1401, 0}},
+    {{-39, -81, 16425, 0, 1418, -1}},
+    {{16, -20, 16386, 2, 1436, 2}},
+    {{-48, -2, 16323, -2, 1446, -1}},
+    {{-21, -47, 16379, 1, 1460, -1}},
+    {{37, -11, 16395, -2, 1472, 1}},
+    {{-50, -52, 16364, 1, 1481, 2}},
+    {{-44, -93, 16341, 0, 1488, -2}},
+    {{-3, -17, 16405, -1, 1493, -1}},
+    {{12, 0, 16402, 0, 1498, -1}},
+    {{163, 66, 16318, 1, 1499, -1}},
+    {{57, -111, 16346, 1, 1497, 1}},
+    {{-22, 0, 16454, 0, 1500, 2}},
+    {{-27, -19, 16449, 1, 1498, 4}},
+    {{-43, -4, 16406, -2, 1490, -2}},
+    {{-14, 4, 16464, 4, 1485, 0}},
+    {{14, 18, 16381, 2, 1480, -1}},
+    {{-108, 1, 16454, 2, 1468, -1}},
+    {{3, -30, 16339, -1, 1460, 2}},
+    {{15, 43, 16359, -1, 1446, 1}},
+    {{-62, 61, 16280, -1, 1432, 2}},
+    {{137, -12, 16377, 1, 1415, -2}},
+    {{-14, -17, 16431, 0, 1397, 0}},
+    {{-15, 52, 16362, 1, 1380, 0}},
+    {{54, -22, 16400, -2, 1359, 2}},
+    {{-1, -76, 16369, 0, 1337, -3}},
+    {{13, 6, 16313, 1, 1309, 1}},
+    {{47, -44, 16333, -1, 1286, 1}},
+    {{31, -20, 16411, -2, 1260, -3}},
+    {{68, -61, 16341, 3, 1233, -2}},
+    {{44, 132, 16398, -1, 1201, 3}},
+    {{-25, -39, 16505, -3, 1170, -3}},
+    {{-34, -23, 16406, -2, 1141, -1}},
+    {{69, -28, 16384, -3, 1104, 1}},
+    {{99, -81, 16370, 0, 1072, 1}},
+    {{30, 36, 16260, -2, 1039, 2}},
+    {{-83, -25, 16405, -1, 998, -2}},
+    {{-52, 96, 16389, 0, 962, -1}},
+    {{16, -4, 16416, -1, 922, 2}},
+    {{26, -44, 16288, 1, 882, -1}},
+    {{-48, -4, 16396, 1, 841, 1}},
+    {{-32, 17, 16381, -1, 799, 4}},
+    {{-28, -13, 16388, 0, 755, 1}},
+    {{-46, 28, 16433, -1, 715, -2}},
+    {{22, 6, 16399, -1, 665, 0}},
+    {{-86, 43, 16421, 0, 623, 0}},
+    {{12, -1, 16352, 0, 575, -1}},
+    {{-2, -58, 16403, 0, 525, 0}},
+    {{-50, -7, 16464, -1, 482, -2}},
+    {{-18, 35, 16403, 0, 435, 2}},
+    {{99, -89, 16310, -2, 384, 1}},
+    {{4, -30, 16369, -2, 338, 0}},
+    {{-5, -86, 16353, -2, 286, 1}},
+    {{-41, 31, 16338, 3, 237, -1}},
+    {{37, 41, 16336, -2, 186, 1}},
+    {{-32, -25, 16399, -1, 139, 1}},
+    {{-32, -44, 16439, -3, 88, 3}},
+    {{-25, -56, 16413, 0, 36, 1}},
+    {{-8, 66, 16418, -1, -12, 1}},
+    {{-10, -52, 16419, 0, -64, 0}},
+    {{13, 45, 16461, 2, -114, 2}},
+    {{-52, -7, 16409, 0, -164, 0}},
+    {{70, 28, 16344, 2, -213, 0}},
+    {{10, 5, 16341, -1, -263, 1}},
+    {{-87, 40, 16453, -2, -312, -1}},
+    {{-62, 64, 16406, 2, -359, 2}},
+    {{-2, 37, 16407, 0, -408, -1}},
+    {{-5, 26, 16428, 1, -459, 0}},
+    {{101, 4, 16421, -2, -505, 1}},
+    {{-29, 3, 16377, 1, -552, -2}},
+    {{31, 113, 16316, -2, -599, -1}},
+    {{-50, 10, 16488, 1, -645, 0}},
+    {{37, 29, 16372, -2, -691, 3}},
+    {{34, 16, 16424, -1, -734, 0}},
+    {{-64, -44, 16396, -1, -780, -1}},
+    {{17, -13, 16448, 3, -821, 1}},
+    {{-4, -33, 16421, 2, -864, -2}},
+    {{56, 41, 16429, 1, -903, -1}},
+    {{-39, 31, 16425, -3, -944, 1}},
+    {{-48, 20, 16337, -1, -982, 0}},
+    {{28, -33, 16366, -1, -1017, 0}},
+    {{6, -28, 16382, 0, -1054, 0}},
+    {{-59, 31, 16444, 0, -1092, 2}},
+    {{-9, 7, 16390, 3, -1125, 0}},
+    {{-15, 36, 16424, 1, -1155, 1}},
+    {{22, 28, 16409, -1, -1184, 1}},
+    {{-127, 8, 16397, -2, -1217, 0}},
+    {{-31, 17, 16315, 2, -1249, -2}},
+    {{11, -93, 16429, 1, -1272, -2}},
+    {{21, -46, 16424, 1, -1301, -1}},
+    {{-69, 76, 16441, -2, -1324, -5}},
+    {{37, 24, 16337, 1, -1347, -1}},
+    {{-8, 8, 16437, 1, -1368, 1}},
+    {{19, 2, 16407, 2, -1387, 2}},
+    {{-1, -19, 16328, -2, -1402, -3}},
+    {{6, 13, 16348, -2, -1421, -1}},
+    {{3, -6, 16353, 0, -1438, 1}},
+    {{45, -16, 16408, -2, -1451, -1}},
+    {{6, -53, 16450, -1, -1460, -2}},
+    {{-28, 35, 16475, 0, -1474, -1}},
+    {{-83, -80, 16516, -2, -1483, 1}},
+    {{27, 1, 16381, 2, -1485, 0}},
+    {{-57, -76, 16371, 2, -1494, 0}},
+    {{24, 13, 16393, 1, -1497, 0}},
+    {{-39, 16, 16330, 1, -1500, -2}},
+    {{114, -21, 16431, -1, -1500, 2}},
+    {{-58, 3, 16450, -1, -1498, 0}},
+    {{-24, -29, 16388, 0, -1496, 1}},
+    {{-7, 12, 16420, 0, -1491, -2}},
+    {{-19, -105, 16320, 0, -1483, 1}},
+    {{-1, -84, 16403, 1, -1477, 0}},
+    {{-73, -63, 16384, 1, -1465, 1}},
+    {{-17, 18, 16406, -1, -1454, 1}},
+    {{50, -45, 16393, -1, -1441, 1}},
+    {{-25, 6, 16390, 1, -1426, 0}},
+    {{2, 41, 16242, -3, -1412, -1}},
+    {{-17, 15, 16356, -1, -1393, -1}},
+    {{10, 42, 16406, 1, -1372, 0}},
+    {{-89, -63, 16349, 1, -1351, 0}},
+    {{49, -24, 16378, 0, -1330, -1}},
+    {{-80, 1, 16415, -3, -1305, 1}},
+    {{31, 29, 16367, 1, -1279, 1}},
+    {{-23, 12, 16393, -1, -1254, 1}},
+    {{-52, 41, 16319, 0, -1225, -1}},
+    {{57, -13, 16385, -1, -1197, 0}},
+    {{-25, 56, 16425, -1, -1166, 0}},
+    {{33, -18, 16462, 0, -1132, 1}},
+    {{-3, 49, 16371, -1, -1097, 0}},
+    {{18, -7, 16471, -2, -1065, -1}},
+    {{55, -73, 16365, -2, -1026, -1}},
+    {{-68, 43, 16364, -1, -989, 0}},
+    {{10, 25, 16324, 3, -949, 0}},
+    {{-97, 53, 16354, 2, -912, -1}},
+    {{-28, -103, 16335, 2, -869, 1}},
+    {{-44, 9, 16404, 0, -834, 0}},
+    {{-27, 26, 16316, 1, -788, 4}},
+    {{73, -43, 16334, 0, -744, 1}},
+    {{-42, 9, 16377, 0, -700, -2}},
+    {{5, -21, 16379, 1, -659, -2}},
+    {{-57, 71, 16453, 1, -611, 1}},
+    {{-49, -79, 16429, -1, -566, 0}},
+    {{58, 20, 16379, -3, -517, 2}},
+    {{9, -31, 16375, 2, -471, -3}},
+    {{-17, 63, 16499, -1, -421, -1}},
+    {{-17, -52, 16339, 0, -371, 0}},
+    {{-12, -3, 16342, 3, -322, 2}},
+    {{-19, 7, 16300, 0, -273, 1}},
+    {{-19, -48, 16366, 2, -226, 0}},
+    {{74, -59, 16279, -1, -176, 0}},
+    {{66, -25, 16390, 0, -125, -1}},
+    {{48, 53, 16300, -1, -77, -1}},
+    {{-70, 131, 16401, 0, -23, 0}},
+    {{-1, 84, 16344, -2, 26, -1}},
+    {{25, -57, 16291, 3, 77, 1}},
+    {{9, -14, 16421, -1, 124, 0}},
+    {{3, -27, 16338, 0, 175, 0}},
+    {{-8, -2, 16339, -1, 226, 1}},
+    {{-85, 33, 16448, 0, 275, -1}},
+    {{96, -66, 16451, 0, 325, 1}},
+    {{11, 65, 16355, 1, 373, -1}},
+    {{34, 6, 16362, -1, 423, -1}},
+    {{-55, -17, 16447, 1, 467, -1}},
+    {{-51, 87, 16311, 1, 519, 0}},
+    {{27, -13, 16393, 0, 562, 2}},
+    {{14, 69, 16395, -1, 612, -1}},
+    {{-40, 24, 16427, 3, 656, -1}},
+    {{25, 10, 16348, 1, 703, -1}},
+    {{50, 88, 16502, -1, 742, 0}},
+    {{25, -17, 16424, 0, 787, 1}},
+    {{-22, -75, 16388, 1, 833, 0}},
+    {{-10, 87, 16369, -2, 874, -1}},
+    {{-20, 104, 16331, 2, 910, 0}},
+    {{17, 55, 16343, 0, 951, 2}},
+    {{-53, 28, 16392, -3, 988, 0}},
+    {{27, 18, 16337, 1, 1027, 2}},
+    {{-2, -76, 16423, -2, 1063, -2}},
+    {{54, 42, 16366, -1, 1098, -1}},
+    {{61, -77, 16309, 1, 1131, 1}},
+    {{12, -16, 16351, -2, 1163, 0}},
+    {{47, 10, 16340, 1, 1195, 1}},
+    {{3, 27, 16333, 3, 1226, -1}},
+    {{-29, -59, 16338, -1, 1252, -1}},
+    {{-13, 32, 16322, 2, 1282, 1}},
+    {{22, -69, 16370, -1, 1305, 1}},
+    {{-52, 0, 16273, 3, 1327, 2}},
+    {{-14, 30, 16347, 1, 1351, 0}},
+    {{-81, -95, 16451, 2, 1372, 0}},
+    {{17, -125, 16371, -3, 1394, -2}},
+    {{-54, 11, 16454, 1, 1413, -2}},
+    {{50, -17, 16386, -1, 1427, -1}},
+    {{29, 12, 16378, 1, 1439, 0}},
+    {{-105, -18, 16388, 0, 1454, 2}},
+    {{4, 10, 16359, 3, 1466, 1}},
+    {{-17, 55, 16404, -2, 1477, -1}},
+    {{8, 31, 16446, 1, 1483, 1}},
+    {{-11, 10, 16362, 1, 1492, 3}},
+    {{31, 67, 16341, 0, 1497, 0}},
+    {{30, -16, 16350, 0, 1499, -1}},
+    {{7, 116, 16332, 0, 1498, 4}},
+    {{55, -9, 16358, 0, 1499, 0}},
+    {{-43, -17, 16434, -2, 1499, -2}},
+    {{2, 55, 16356, 1, 1497, 1}},
+    {{112, -24, 16393, 0, 1486, 1}},
+    {{-53, -44, 16396, 0, 1484, -1}},
+    {{-52, 14, 16340, 1, 1474, 1}},
+    {{3, 22, 16320, 1, 1465, -1}},
+    {{12, -39, 16366, -1, 1451, 1}},
+    {{-120, -73, 16415, 0, 1435, 1}},
+    {{18, -29, 16496, 0, 1424, 1}},
+    {{0, 26, 16366, -2, 1405, 1}},
+    {{80, -53, 16471, 1, 1388, 1}},
+    {{-66, 8, 16362, 0, 1370, 0}},
+    {{-98, -84, 16448, 0, 1344, 1}},
+    {{-1, -12, 16367, -2, 1323, 0}},
+    {{57, 16, 16356, 3, 1301, 0}},
+    {{33, -18, 16359, 1, 1273, 0}},
+    {{-50, 25, 16430, 0, 1246, 4}},
+    {{1, -18, 16382, 1, 1217, -1}},
+    {{67, -35, 16446, -2, 1186, -2}},
+    {{27, -17, 16331, -1, 1155, 2}},
+    {{11, 69, 16431, 2, 1120, -3}},
+    {{-51, -56, 16318, -2, 1087, -3}},
+    {{61, -54, 16402, 0, 1055, -3}},
+    {{35, 85, 16435, 0, 1018, 3}},
+    {{35, 30, 16420, -2, 981, -1}},
+    {{35, 23, 16348, -1, 943, 0}},
+    {{-59, 27, 16353, 1, 901, 1}},
+    {{45, -11, 16411, -1, 858, 1}},
+    {{-16, -40, 16451, 3, 819, 2}},
+    {{35, -31, 16371, 0, 777, -1}},
+    {{-8, -10, 16433, 2, 734, 0}},
+    {{25, 26, 16417, 0, 690, 1}},
+    {{-29, 30, 16340, -1, 642, -1}},
+    {{-8, -9, 16429, 2, 598, 0}},
+    {{52, -39, 16327, 0, 554, -1}},
+    {{-8, -73, 16334, -1, 502, -2}},
+    {{-21, -9, 16358, 2, 458, 1}},
+    {{35, 72, 16386, -3, 408, -2}},
+    {{8, 68, 16311, 0, 362, 0}},
+    {{66, -14, 16423, 1, 310, -3}},
+    {{23, -64, 16389, -1, 263, -1}},
+    {{-14, -11, 16397, 0, 214, -2}},
+    {{-40, -5, 16356, -2, 162, -1}},
+    {{34, 45, 16375, -1, 113, -2}},
+    {{18, 0, 16279, -1, 66, 1}},
+    {{-35, -48, 16324, 0, 13, 0}},
+    {{-12, 15, 16412, 0, -39, -1}},
+    {{25, 67, 16436, -1, -90, 2}},
+    {{47, -30, 16460, 2, -139, 0}},
+    {{19, -11, 16352, 3, -189, -1}},
+    {{-61, -15, 16339, -1, -238, -2}},
+    {{13, -58, 16349, -1, -288, 3}},
+    {{67, -126, 16479, 1, -337, -2}},
+    {{83, -31, 16375, -2, -387, -3}},
+    {{-45, -24, 16386, 2, -432, 1}},
+    {{-2, 73, 16389, -1, -480, -1}},
+    {{87, 94, 16362, 1, -527, 1}},
+    {{51, -8, 16335, 1, -575, -2}},
+    {{1, -26, 16476, -4, -619, 0}},
+    {{49, 17, 16334, 2, -668, 2}},
+    {{-39, -116, 16374, -2, -711, 1}},
+    {{-64, 53, 16374, -1, -754, 2}},
+    {{7, -65, 16444, 1, -800, -1}},
+    {{2, 56, 16327, 1, -838, 3}},
+    {{-34, 68, 16359, 1, -880, 1}},
+    {{62, 53, 16421, 0, -923, 0}},
+    {{65, 8, 16364, -1, -963, 1}},
+    {{-52, 17, 16381, 2, -999, -2}},
+    {{22, 10, 16366, 1, -1036, 3}},
+    {{37, 24, 16328, 1, -1069, -1}},
+    {{-42, -54, 16354, 1, -1107, -1}},
+    {{72, 7, 16366, 0, -1140, 0}},
+    {{14, -105, 16435, 0, -1173, 1}},
+    {{38, 6, 16393, -2, -1205, 1}},
+    {{14, 28, 16356, 1, -1228, -2}},
+    {{-47, -15, 16467, 3, -1260, 2}},
+    {{-10, -6, 16344, 0, -1290, 0}},
+    {{-5, -83, 16385, -1, -1312, -2}},
+    {{33, -77, 16349, 1, -1334, -1}},
+    {{-20, 30, 16470, -1, -1357, 0}},
+    {{-26, 59, 16438, 0, -1379, 1}},
+    {{6, 58, 16282, -1, -1398, 1}},
+    {{6, -2, 16422, -2, -1416, 0}},
+    {{27, -96, 16431, -2, -1430, 2}}};
+const mvmt::GestureFeatureExtractor::sample_t RAW_2[] = {
+    {{28, 56, 27148, 270, 116, -2}},
+    {{7, 1950, 27767, 257, 45, 124}},
+    {{85, 4043, 28125, 252, -22, 249}},
+    {{4, 5940, 28544, 232, -91, 378}},
+    {{-30, 7865, 28881, 217, -149, 493}},
+    {{28, 9816, 29063, 194, -224, 610}},
+    {{-10, 11588, 29125, 176, -283, 717}},
+    {{2, 13231, 29189, 166, -349, 835}},
+    {{-45, 14968, 29073, 140, -406, 928}},
+    {{60, 16446, 29021, 112, -461, 1028}},
+    {{3, 17836, 28741, 91, -516, 1117}},
+    {{-42, 19147, 28359, 63, -563, 1198}},
+    {{29, 20328, 28064, 41, -602, 1270}},
+    {{18, 21298, 27481, 21, -649, 1329}},
+    {{-4, 22121, 26931, -10, -684, 1381}},
+    {{17, 22869, 26316, -32, -719, 1426}},
+    {{25, 23304, 25550, -57, -746, 1459}},
+    {{-54, 23742, 24814, -84, -766, 1488}},
+    {{23, 23981, 23969, -102, -786, 1500}},
+    {{-29, 23981, 23094, -130, -799, 1503}},
+    {{22, 23816, 22138, -152, -797, 1496}},
+    {{-26, 23531, 21122, -174, -799, 1467}},
+    {{14, 23058, 20139, -191, -796, 1444}},
+    {{-74, 22467, 19060, -210, -787, 1402}},
+    {{10, 21657, 18109, -228, -764, 1359}},
+    {{-63, 20810, 17039, -246, -747, 1297}},
+    {{-68, 19731, 15944, -253, -717, 1228}},
+    {{-78, 18432, 14935, -270, -684, 1153}},
+    {{19, 17094, 13780, -276, -644, 1068}},
+    {{-45, 15696, 12737, -287, -600, 981}},
+    {{-8, 14054, 11722, -294, -555, 881}},
+    {{-46, 12528, 10719, -291, -507, 775}},
+    {{-8, 10644, 9861, -302, -456, 661}},
+    {{-16, 8851, 8897, -303, -401, 555}},
+    {{5, 6966, 8017, -300, -338, 434}},
+    {{-78, 5046, 7287, -295, -277, 308}},
+    {{42, 2992, 6515, -288, -210, 184}},
+    {{4, 1052, 5884, -279, -142, 69}},
+    {{7, -1037, 5316, -266, -77, -63}},
+    {{68, -2947, 4826, -255, -13, -186}},
+    {{-58, -5021, 4387, -241, 53, -314}},
+    {{-61, -6997, 4061, -229, 123, -430}},
+    {{44, -8723, 3842, -209, 181, -555}},
+    {{0, -10668, 3612, -192, 253, -669}},
+    {{-47, -12445, 3578, -167, 317, -780}},
+    {{29, -14062, 3589, -146, 373, -881}},
+    {{44, -15576, 3768, -129, 432, -983}},
+    {{-46, -17089, 3863, -107, 487, -1075}},
+    {{-55, -18562, 4156, -77, 532, -1157}},
+    {{-24, -19733, 4514, -58, 583, -1236}},
+    {{77, -20759, 5099, -30, 629, -1300}},
+    {{-9, -21730, 5553, -3, 665, -1353}},
+    {{15, -22468, 6181, 27, 702, -1407}},
+    {{-50, -23159, 6758, 42, 731, -1448}},
+    {{-42, -23618, 7581, 80, 757, -1472}},
+    {{-14, -23842, 8428, 94, 774, -1490}},
+    {{38, -24017, 9194, 120, 789, -1501}},
+    {{69, -23925, 10129, 145, 799, -1497}},
+    {{30, -23658, 11074, 161, 800, -1483}},
+    {{-22, -23385, 12050, 185, 797, -1460}},
+    {{64, -22806, 13202, 205, 783, -1423}},
+    {{19, -22195, 14201, 218, 776, -1381}},
+    {{-26, -21210, 15284, 245, 759, -1330}},
+    {{-39, -20315, 16302, 254, 727, -1267}},
+    {{52, -19025, 17323, 263, 698, -1198}},
+    {{-78, -17802, 18473, 275, 661, -1113}},
+    {{-53, -16435, 19497, 280, 626, -1030}},
+    {{49, -14780, 20504, 286, 577, -925}},
+    {{18, -13265, 21586, 298, 528, -825}},
+    {{80, -11499, 22531, 300, 475, -721}},
+    {{-24, -9755, 23388, 300, 419, -614}},
+    {{44, -7868, 24261, 299, 363, -488}},
+    {{31, -5914, 25027, 295, 308, -376}},
+    {{10, -4112, 25851, 286, 245, -245}},
+    {{6, -1992, 26537, 283, 176, -124}},
+    {{-16, -28, 27185, 271, 118, 3}},
+    {{-69, 1995, 27710, 263, 47, 129}},
+    {{-1, 4085, 28192, 251, -18, 249}},
+    {{9, 5858, 28549, 228, -87, 377}},
+    {{32, 7905, 28808, 214, -153, 493}},
+    {{-26, 9702, 29053, 195, -220, 603}},
+    {{28, 11598, 29204, 175, -288, 720}},
+    {{61, 13273, 29172, 162, -345, 833}},
+    {{-17, 14905, 29164, 137, -401, 934}},
+    {{-12, 16504, 29098, 116, -461, 1029}},
+    {{15, 17705, 28650, 90, -510, 1116}},
+    {{-88, 19134, 28361, 67, -566, 1196}},
+    {{50, 20292, 27971, 42, -609, 1266}},
+    {{87, 21378, 27451, 20, -644, 1328}},
+    {{6, 22104, 26955, -11, -686, 1383}},
+    {{-24, 22780, 26286, -32, -719, 1425}},
+    {{-1, 23328, 25472, -56, -740, 1460}},
+    {{23, 23702, 24739, -87, -767, 1489}},
+    {{32, 24016, 24078, -109, -782, 1495}},
+    {{-24, 23969, 23006, -128, -791, 1503}},
+    {{-88, 23888, 22059, -156, -794, 1490}},
+    {{-5, 23553, 21166, -173, -801, 1473}},
+    {{-20, 23159, 20167, -191, -794, 1451}},
+    {{3, 22519, 19137, -213, -779, 1405}},
+    {{-53, 21679, 18103, -231, -762, 1359}},
+    {{-31, 20834, 16861, -247, -745, 1299}},
+    {{-42, 19703, 15929, -257, -716, 1230}},
+    {{7, 18532, 14755, -267, -683, 1160}},
+    {{-69, 17079, 13719, -285, -646, 1072}},
+    {{-1, 15682, 12787, -289, -607, 980}},
+    {{35, 14136, 11656, -289, -554, 886}},
+    {{-37, 12365, 10773, -301, -503, 776}},
+    {{-10, 10684, 9853, -297, -454, 666}},
+    {{72, 8864, 8922, -299, -403, 548}},
+    {{-92, 6856, 8081, -292, -340, 433}},
+    {{-64, 4953, 7326, -289, -275, 311}},
+    {{107, 3028, 6538, -289, -207, 189}},
+    {{13, 960, 5863, -282, -142, 64}},
+    {{27, -944, 5328, -266, -81, -64}},
+    {{-46, -3038, 4834, -257, -10, -191}},
+    {{28, -5056, 4434, -239, 53, -309}},
+    {{-47, -6870, 4072, -226, 125, -436}},
+    {{-83, -8875, 3884, -207, 187, -559}},
+    {{-32, -10558, 3562, -195, 245, -669}},
+    {{-50, -12459, 3636, -172, 310, -778}},
+    {{-43, -14099, 3544, -145, 379, -878}},
+    {{11, -15713, 3692, -129, 431, -981}},
+    {{34, -17149, 4008, -108, 488, -1075}},
+    {{15, -18487, 4197, -84, 542, -1159}},
+    {{-17, -19611, 4493, -55, 591, -1228}},
+    {{-31, -20741, 5003, -31, 628, -1305}},
+    {{10, -21720, 5540, -12, 671, -1361}},
+    {{8, -22477, 6082, 19, 702, -1406}}};
+const mvmt::GestureFeatureExtractor::sample_t RAW_3[] = {
+    {{34, 88, 16429, 1, 0, 3}},
+    {{356, -48, 16367, 0, 0, 1}},
+    {{457, 48, 16356, 1, 0, 1}},
+    {{785, -43, 16448, -2, -4, -1}},
+    {{1102, 2, 16377, 1, 3, 0}},
+    {{1274, 53, 16407, -3, -1, -5}},
+    {{1639, 50, 16392, -6, 1, 3}},
+    {{1761, 31, 16387, -1, 2, 1}},
+    {{2157, -28, 16371, 1, -1, 3}},
+    {{2345, 54, 16353, 0, 3, -1}},
+    {{2492, -36, 16250, 5, -2, -2}},
+    {{2724, -20, 16375, 3, 1, -1}},
+    {{2942, -10, 16398, -1, -3, 0}},
+    {{3116, 54, 16373, -1, 7, -1}},
+    {{3408, 10, 16277, -4, 0, 1}},
+    {{3542, 20, 16349, 2, -2, -1}},
+    {{3648, 62, 16392, 5, -3, 3}},
+    {{3989, 4, 16371, -2, 0, -2}},
+    {{4081, -16, 16385, -1, 0, -1}},
+    {{4183, -14, 16351, -3, -4, 0}},
+    {{4325, 72, 16370, 1, 7, -1}},
+    {{4479, 16, 16366, -2, -1, -1}},
+    {{4524, 9, 16289, -6, -2, 2}},
+    {{4591, 24, 16352, 4, -2, -2}},
+    {{4581, 28, 16440, 6, -1, -3}},
+    {{4813, -41, 16409, 4, -5, 3}},
+    {{4811, 37, 16461, 1, 1, 4}},
+    {{4763, -84, 16346, 1, 6, -4}},
+    {{4717, 59, 16416, -1, 0, 0}},
+    {{4779, 5, 16306, -2, -1, -4}},
+    {{4802, 6, 16452, -1, 0, 0}},
+    {{4650, -28, 16393, 4, -4, 0}},
+    {{4613, -49, 16457, -1, -1, -3}},
+    {{4585, 66, 16392, 2, -4, -5}},
+    {{4565, 35, 16413, 1, 1, 0}},
+    {{4452, -83, 16382, 3, 3, 3}},
+    {{4344, 19, 16355, 0, 3, 1}},
+    {{4380, 44, 16324, -1, -3, 0}},
+    {{4069, -13, 16361, -6, -5, 0}},
+    {{3943, -71, 16380, 5, -1, 5}},
+    {{3766, 55, 16318, 0, 1, 1}},
+    {{3646, -24, 16452, 0, -3, 3}},
+    {{3379, -173, 16453, -5, 5, 0}},
+    {{3202, -1, 16409, -2, -4, 2}},
+    {{3045, 21, 16374, -3, -1, -5}},
+    {{2866, -5, 16414, 2, 2, 0}},
+    {{2596, -52, 16412, -6, -4, 0}},
+    {{2361, 20, 16413, 1, 0, 7}},
+    {{2222, 25, 16514, 3, -1, -2}},
+    {{1835, -54, 16397, -1, 4, -2}},
+    {{1658, -9, 16461, -2, 2, 5}},
+    {{1374, -50, 16368, -2, 2, 3}},
+    {{1147, -25, 16388, 3, -5, -5}},
+    {{836, -25, 16352, 4, 6, -3}},
+    {{567, -17, 16402, -2, 2, -1}},
+    {{342, 9, 16343, 1, -1, -6}},
+    {{-34, 49, 16429, 0, 1, 1}},
+    {{-204, 43, 16425, 0, 4, 6}},
+    {{-524, -41, 16404, -3, 1, -4}},
+    {{-729, 3, 16385, -1, 0, -3}},
+    {{-986, -7, 16484, 2, 2, 5}},
+    {{-1237, 59, 16403, 4, -1, -4}},
+    {{-1488, -32, 16319, -1, 4, -2}},
+    {{-1713, 8, 16426, 0, 2, -2}}};
+
+const GestureRawVector GESTURE_RAW_VECTORS[] = {
+    {"flick left at 562.5 Hz, gyro shift 1",
+     10,
+     1,
+     RAW_0,
+     sizeof(RAW_0) / sizeof(RAW_0[0]),
+     1,
+     {{
+      {{0, 0, 1024, 0, 0, 0}},
+      {{2, 0, 1024, 0, 0, 0}},
+      {{-1, 0, 1022, 0, 0, 0}},
+      {{1, 0, 1023, 0, 0, 0}},
+      {{0, 0, 1024, 0, 0, 0}},
+      {{0, 0, 1022, 0, 0, 0}},
+      {{0, 0, 1022, 0, 0, 0}},
+      {{0, -1, 1022, 0, 0, 0}},
+      {{0, 1, 1023, 0, 0, 0}},
+      {{-1, 0, 1024, 0, 0, 0}},
+      {{2, 0, 1024, 0, 0, 0}},
+      {{0, -1, 1022, 0, 0, 0}},
+      {{-1, 0, 1024, 0, 0, 0}},
+      {{0, 0, 1024, 0, 0, 0}},
+      {{0, 0, 1025, 0, 0, 0}},
+      {{0, -1, 1023, 0, 0, 0}},
+      {{0, -1, 1024, 0, 0, 0}},
+      {{0, 0, 1024, 0, 0, -15}},
+      {{1, 0, 1025, 0, 0, -92}},
+      {{0, 0, 1024, 0, 0, -217}},
+      {{1, 0, 1024, 0, 0, -351}},
+      {{1, -1, 1023, 0, 0, -455}},
+      {{0, 0, 1024, 0, 0, -496}},
+      {{0, 0, 1024, 0, 0, -462}},
+      {{0, 0, 1025, 0, 0, -364}},
+      {{0, -2, 1023, 0, 0, -231}},
+      {{0, 0, 1023, 0, 0, -103}},
+      {{0, 0, 1023, 0, 0, -20}},
+      {{-1, 2, 1025, 0, 0, 0}},
+      {{0, 2, 1025, 0, 0, 0}},
+      {{0, 0, 1022, 0, 0, 0}},
+      {{0, 0, 1024, 0, 0, 0}}}},
+     {{0, 0, 1023, 0, 0, -87, 0, 0, 33, 0, 0, 158, 0, 0, 0, 0, 0, 32, 0, 0, 0, 0, 0, -175}},
+     0},
+    {"twist at 562.5 Hz, gyro shift 1",
+     10,
+     1,
+     RAW_1,
+     sizeof(RAW_1) / sizeof(RAW_1[0]),
+     2,
+     {{
+      {{0, 3, 1026, 0, 27, 0}},
+      {{0, -1, 1023, 0, 87, 0}},
+      {{0, 0, 1022, 0, 136, 0}},
+      {{0, 0, 1023, 0, 170, 0}},
+      {{0, -1, 1024, 0, 186, 0}},
+      {{0, 0, 1024, 0, 180, 0}},
+      {{1, -1, 1024, 0, 155, 0}},
+      {{0, 0, 1023, 0, 112, 0}},
+      {{0, 0, 1023, 0, 56, 0}},
+      {{0, 0, 1024, 0, -4, 0}},
+      {{0, 2, 1025, 0, -65, 0}},
+      {{0, 0, 1025, 0, -119, 0}},
+      {{0, 0, 1025, 0, -160, 0}},
+      {{0, -1, 1025, 0, -182, 0}},
+      {{0, -1, 1024, 0, -185, 0}},
+      {{-1, 0, 1022, 0, -166, 0}},
+      {{0, 0, 1024, 0, -130, 0}},
+      {{0, 0, 1024, 0, -78, 0}},
+      {{0, 0, 1020, 0, -18, 0}},
+      {{0, 0, 1024, 0, 43, 0}},
+      {{0, 2, 1024, 0, 100, 0}},
+      {{1, -1, 1021, 0, 146, 0}},
+      {{-1, 0, 1023, 0, 176, 0}},
+      {{0, 1, 1023, 0, 186, 0}},
+      {{-1, -1, 1024, 0, 175, 0}},
+      {{1, 0, 1024, 0, 145, 0}},
+      {{0, 0, 1024, 0, 99, 0}},
+      {{0, 0, 1022, 0, 41, 0}},
+      {{1, -1, 1023, 0, -20, 0}},
+      {{0, 0, 1023, 0, -80, 0}},
+      {{1, 0, 1023, 0, -131, 0}},
+      {{0, 0, 1024, 0, -167, 0}}}},
+     {{0, 0, 1023, 0, 22, 0, 0, 0, 32, 0, 127, 0, 0, 0, 1, 0, 40, 0, 0, 0, 0, 0, 16, 0}},
+     0},
+    {"shake at 225 Hz, gyro shift 0",
+     4,
+     0,
+     RAW_2,
+     sizeof(RAW_2) / sizeof(RAW_2[0]),
+     3,
+     {{
+      {{1, 187, 1743, 15, 0, 11}},
+      {{0, 664, 1816, 11, -15, 41}},
+      {{0, 1068, 1799, 6, -30, 66}},
+      {{0, 1353, 1699, 0, -41, 84}},
+      {{0, 1484, 1522, -5, -48, 92}},
+      {{-1, 1451, 1288, -11, -49, 90}},
+      {{-3, 1259, 1031, -15, -45, 78}},
+      {{-1, 927, 764, -17, -36, 57}},
+      {{-1, 492, 532, -18, -23, 30}},
+      {{1, 0, 352, -17, -6, 0}},
+      {{-1, -490, 248, -13, 9, -30}},
+      {{0, -924, 231, -8, 25, -58}},
+      {{0, -1262, 301, -2, 37, -78}},
+      {{-1, -1454, 452, 3, 46, -90}},
+      {{1, -1484, 663, 9, 49, -92}},
+      {{0, -1351, 921, 14, 47, -84}},
+      {{0, -1063, 1184, 17, 40, -66}},
+      {{1, -662, 1433, 18, 27, -41}},
+      {{0, -188, 1634, 17, 13, -11}},
+      {{0, 310, 1769, 14, -3, 19}},
+      {{0, 773, 1821, 10, -19, 48}},
+      {{0, 1150, 1782, 4, -33, 71}},
+      {{1, 1399, 1658, -1, -43, 87}},
+      {{0, 1493, 1466, -7, -48, 93}},
+      {{-1, 1420, 1227, -12, -49, 88}},
+      {{-2, 1189, 957, -16, -43, 74}},
+      {{0, 826, 704, -18, -33, 51}},
+      {{0, 370, 482, -18, -19, 23}},
+      {{0, -126, 319, -16, -2, -7}},
+      {{-3, -605, 236, -12, 13, -38}},
+      {{0, -1022, 241, -7, 28, -63}},
+      {{0, -1321, 329, -1, 40, -82}}}},
+     {{0, 183, 1018, -2, -6, 11, 1, 1022, 590, 12, 33, 63, 0, 324, 158, 3, 10, 20, 0, 126, 117, 1, -3, 8}},
+     0},
+    {"pointing at 112.5 Hz, gyro shift 0",
+     2,
+     0,
+     RAW_3,
+     sizeof(RAW_3) / sizeof(RAW_3[0]),
+     0,
+     {{
+      {{12, 1, 1024, 0, 0, 0}},
+      {{38, 0, 1025, 0, 0, 0}},
+      {{74, 1, 1024, 0, 0, 0}},
+      {{106, 2, 1024, 0, 0, 0}},
+      {{140, 0, 1022, 0, 0, 0}},
+      {{163, -1, 1019, 0, 0, 0}},
+      {{189, 1, 1024, 0, 0, 0}},
+      {{217, 0, 1019, 0, 0, 0}},
+      {{238, 2, 1023, 0, 0, 0}},
+      {{258, 0, 1023, 0, 0, 0}},
+      {{275, 2, 1023, 0, 0, 0}},
+      {{284, 1, 1020, 0, 0, 0}},
+      {{293, 0, 1026, 0, 0, 0}},
+      {{299, -1, 1025, 0, 0, 0}},
+      {{296, 2, 1022, 0, 0, 0}},
+      {{295, 0, 1026, 0, 0, 0}},
+      {{287, 0, 1026, 0, 0, 0}},
+      {{281, -1, 1024, 0, 0, 0}},
+      {{272, 1, 1021, 0, 0, 0}},
+      {{250, -2, 1023, 0, 0, 0}},
+      {{231, 0, 1024, 0, 0, 0}},
+      {{205, -5, 1026, 0, 0, 0}},
+      {{184, 0, 1024, 0, 0, 0}},
+      {{154, -1, 1025, 0, 0, 0}},
+      {{126, 0, 1028, 0, 0, 0}},
+      {{94, -1, 1025, 0, 0, 0}},
+      {{61, -1, 1023, 0, 0, 0}},
+      {{28, 0, 1023, 0, 0, 0}},
+      {{-7, 2, 1026, 0, 0, 0}},
+      {{-39, -1, 1024, 0, 0, 0}},
+      {{-69, 1, 1027, 0, 0, 0}},
+      {{-100, 0, 1023, 0, 0, 0}}}},
+     {{160, 0, 1023, 0, 0, 0, 119, 1, 40, 0, 0, 0, 22, 1, 2, 0, 0, 0, -76, -1, 1, 0, 0, 0}},
+     0}};
+
+#endif
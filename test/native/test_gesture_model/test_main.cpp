@@ -0,0 +1,48 @@
+#include <unity.h>
+
+#include "gesture_model.h"
+#include "gesture_vectors.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_features_match_reference() {
+  for (const auto &vector : GESTURE_VECTORS) {
+    mvmt::GestureFeatureExtractor extractor(1, 0);
+    bool ready = false;
+    for (const auto &sample : vector.samples) {
+      ready = extractor.add_sample(sample);
+    }
+    TEST_ASSERT_TRUE_MESSAGE(ready, vector.name);
+    for (std::size_t i = 0; i < vector.features.size(); i++) {
+      TEST_ASSERT_EQUAL_INT32_MESSAGE(vector.features[i], extractor.get_current()[i], vector.name);
+    }
+  }
+}
+
+void test_inference_matches_reference() {
+  for (const auto &vector : GESTURE_VECTORS) {
+    mvmt::GestureNetwork network(mvmt::GESTURE_MODEL);
+    std::size_t recognized = network.classify(vector.features);
+    for (std::size_t o = 0; o < vector.scores.size(); o++) {
+      TEST_ASSERT_EQUAL_INT32_MESSAGE(vector.scores[o], network.m_score[o], vector.name);
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(vector.recognized, recognized, vector.name);
+  }
+}
+
+void test_model_recognizes_gestures() {
+  // The shipped model is a synthetic placeholder, but it must still tell these textbook gestures apart
+  for (const auto &vector : GESTURE_VECTORS) {
+    mvmt::GestureNetwork network(mvmt::GESTURE_MODEL);
+    TEST_ASSERT_EQUAL_MESSAGE(vector.gesture, network.classify(vector.features), vector.name);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_features_match_reference);
+  RUN_TEST(test_inference_matches_reference);
+  RUN_TEST(test_model_recognizes_gestures);
+  return UNITY_END();
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+
+#include "mag_calibration.h"
+
+// Calibration as configured in main.cpp, fed by the AK09916 at 100 Hz
+constexpr float EXPECTED_FIELD = 50;
+constexpr float MEMORY = 2000;
+constexpr std::size_t INTERVAL = 50;
+constexpr int READINGS_PER_SECOND = 100;
+constexpr double FIELD = 44; // Strength of the simulated Earth's field in uT
+
+/// @brief A magnetometer with hard-iron offset, skewed soft-iron distortion and noise, reporting the Earth's field as
+/// the board turns.
+class Magnetometer {
+  std::mt19937 m_generator{20948};
+  std::normal_distribution<double> m_noise{0.0, 0.5};
+  Eigen::Matrix3d m_soft_iron;
+
+public:
+  const Eigen::Vector3d offset{30, -20, 10};
+
+  Magnetometer() {
+    m_soft_iron << 1.15, 0.08, -0.05, //
+        0.08, 0.9, 0.06,              //
+        -0.05, 0.06, 1.05;
+  }
+  /// @brief Read the field with the board at a given orientation.
+  Eigen::Vector3f read(const Eigen::Quaterniond &orientation) {
+    Eigen::Vector3d field = orientation.conjugate() * Eigen::Vector3d(FIELD * 0.45, 0, -FIELD * 0.89);
+    Eigen::Vector3d noise(m_noise(m_generator), m_noise(m_generator), m_noise(m_generator));
+    return (m_soft_iron * field + offset + noise).cast<float>();
+  }
+};
+
+/// @brief Turn the board by a random rotation for each reading, about random axes at hand speeds.
+class Tumbler {
+  std::mt19937 m_generator{1125};
+  std::normal_distribution<double> m_rate{0.0, 2.0};
+  Eigen::Quaterniond m_orientation = Eigen::Quaterniond::Identity();
+  Eigen::Vector3d m_velocity = Eigen::Vector3d::Zero();
+
+public:
+  const Eigen::Quaterniond &step() {
+    // Angular velocity wanders smoothly, as a hand's would
+    Eigen::Vector3d kick(m_rate(m_generator), m_rate(m_generator), m_rate(m_generator));
+    m_velocity = 0.98 * m_velocity + 0.2 * kick;
+    double angle = m_velocity.norm() / READINGS_PER_SECOND;
+    if (angle > 0) {
+      m_orientation = m_orientation * Eigen::Quaterniond(Eigen::AngleAxisd(angle, m_velocity.normalized()));
+    }
+    return m_orientation;
+  }
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_fit_recovers_distortion() {
+  mvmt::MagCalibrator calibrator(EXPECTED_FIELD, MEMORY, INTERVAL);
+  Magnetometer magnetometer;
+  Tumbler tumbler;
+  int fits = 0;
+  for (int i = 0; i < 60 * READINGS_PER_SECOND; i++) {
+    fits += calibrator.add_measurement(magnetometer.read(tumbler.step()));
+  }
+  TEST_ASSERT_GREATER_THAN(0, fits);
+  const mvmt::MagCalibration &calibration = calibrator.get_current();
+  double offset_error = (calibration.offset.cast<double>() - magnetometer.offset).norm();
+  // Corrected readings should all have about the same strength, whichever way the board faces
+  double raw_min = INFINITY, raw_max = 0, min = INFINITY, max = 0;
+  for (int i = 0; i < 20 * READINGS_PER_SECOND; i++) {
+    Eigen::Vector3f raw = magnetometer.read(tumbler.step());
+    raw_min = std::min<double>(raw_min, raw.norm());
+    raw_max = std::max<double>(raw_max, raw.norm());
+    double corrected = calibration.apply(raw).norm();
+    min = std::min(min, corrected);
+    max = std::max(max, corrected);
+  }
+  char message[112];
+  snprintf(message, sizeof(message), "%d fits, offset error %.2f uT, magnitudes %.1f..%.1f uT (raw %.1f..%.1f uT)",
+           fits, offset_error, min, max, raw_min, raw_max);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(2.0, offset_error);
+  // The soft-iron fit keeps the distorted field's mean strength rather than the true one, and noise alone spreads the
+  // magnitudes by a few uT
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.1 * (min + max) / 2, max - min);
+}
+
+void test_narrow_motion_is_not_fitted() {
+  mvmt::MagCalibrator calibrator(EXPECTED_FIELD, MEMORY, INTERVAL);
+  Magnetometer magnetometer;
+  // Five minutes lying still, then a minute turning about a single axis, never see enough directions to fit
+  for (int i = 0; i < 300 * READINGS_PER_SECOND; i++) {
+    TEST_ASSERT_FALSE(calibrator.add_measurement(magnetometer.read(Eigen::Quaterniond::Identity())));
+  }
+  for (int i = 0; i < 60 * READINGS_PER_SECOND; i++) {
+    Eigen::Quaterniond turned(Eigen::AngleAxisd(i * 0.02, Eigen::Vector3d::UnitZ()));
+    TEST_ASSERT_FALSE(calibrator.add_measurement(magnetometer.read(turned)));
+  }
+  TEST_ASSERT_TRUE(calibrator.get_current().offset.isZero());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_fit_recovers_distortion);
+  RUN_TEST(test_narrow_motion_is_not_fitted);
+  return UNITY_END();
+}
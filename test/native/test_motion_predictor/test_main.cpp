@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <unity.h>
+
+#include "../motion_traces.h"
+#include "gauss_filter.h"
+#include "motion_predictor.h"
+
+// Smoothing and prediction as configured in main.cpp for the balanced profile with interrupt-driven acquisition: tilt
+// is smoothed at the sample rate and tracked once per published motion, which is every other sample
+constexpr double STDDEV = 0.025;
+constexpr double Z_CUTOFF = 2;
+constexpr std::size_t REPORT_DECIMATION = 2;
+constexpr double PREDICTION_ALPHA = 0.7;
+constexpr double PREDICTION_BETA = 0.3;
+constexpr double DOWNSTREAM_DELAY = 0.02; // Stand-in for the loop and Bluetooth delay after the sensor task, in seconds
+constexpr double SETTLE_TIME = 1.0;       // Seconds skipped at the start of each trace while the filters settle
+constexpr double REACHES_DURATION = 60;
+
+/// @brief Run a trace through smoothing and prediction, holding each published motion until the next, as the cursor
+/// sees it.
+std::vector<double> predict(const traces::Trace &trace, double horizon) {
+  mvmt::GaussianFilter<double> filter(STDDEV, Z_CUTOFF, traces::TIME_DELTA, 0.0);
+  mvmt::AlphaBetaPredictor<double> predictor(PREDICTION_ALPHA, PREDICTION_BETA, REPORT_DECIMATION * traces::TIME_DELTA,
+                                             0.0);
+  predictor.set_horizon(horizon);
+  std::vector<double> output;
+  output.reserve(trace.measured.size());
+  double published = 0;
+  for (std::size_t i = 0; i < trace.measured.size(); i++) {
+    filter.add_measurement(trace.measured[i]);
+    if (i % REPORT_DECIMATION == 0) {
+      predictor.add_measurement(filter.get_current());
+      published = predictor.get_current();
+    }
+    output.push_back(published);
+  }
+  return output;
+}
+
+/// @brief Get the RMS change between successive published motions while held still, in mg.
+double jitter(const std::vector<double> &output) {
+  double sum = 0;
+  std::size_t count = 0;
+  for (auto i = static_cast<std::size_t>(SETTLE_TIME / traces::TIME_DELTA); i + REPORT_DECIMATION < output.size();
+       i += REPORT_DECIMATION) {
+    double change = output[i + REPORT_DECIMATION] - output[i];
+    sum += change * change;
+    count++;
+  }
+  return std::sqrt(sum / count);
+}
+
+/// @brief How prediction at one horizon trades lag for overshoot on the shared traces.
+struct Response {
+  double error_now;   // RMS error against the hand now, in mg, while aiming
+  double error_ahead; // RMS error against the hand after the downstream delay, in mg, while aiming
+  double ramp_lag;    // Delay behind a steady tilt, in seconds
+  double overshoot;   // Furthest the output passes the end of a flick, in mg
+  double jitter;      // RMS change between published motions while held still, in mg
+};
+
+constexpr double HORIZONS[] = {0, 0.016, 0.032, 0.048, 0.064}; // Horizons compared, in seconds
+
+Response measure(double horizon) {
+  static const auto reaches = traces::reaches(REACHES_DURATION);
+  static const auto ramp = traces::ramp(), flick = traces::flick(), hold = traces::hold();
+  auto aiming = predict(reaches, horizon);
+  auto flicked = predict(flick, horizon);
+  return {traces::rms_error(aiming, reaches, SETTLE_TIME),
+          traces::rms_error(aiming, reaches, SETTLE_TIME, DOWNSTREAM_DELAY),
+          traces::ramp_lag(predict(ramp, horizon), ramp),
+          *std::max_element(flicked.begin(), flicked.end()) - traces::FLICK_SIZE, jitter(predict(hold, horizon))};
+}
+
+/// @brief Get the response at each of HORIZONS, measuring and reporting them all the first time.
+const Response &response(std::size_t index) {
+  static Response responses[std::size(HORIZONS)];
+  static bool measured = false;
+  if (!measured) {
+    for (std::size_t i = 0; i < std::size(HORIZONS); i++) {
+      responses[i] = measure(HORIZONS[i]);
+      char message[128];
+      snprintf(message, sizeof(message),
+               "horizon %2.0f ms: error %.1f mg now, %.1f mg ahead, ramp lag %.1f ms, overshoot %.1f mg, "
+               "jitter %.2f mg",
+               HORIZONS[i] * 1000, responses[i].error_now, responses[i].error_ahead, responses[i].ramp_lag * 1000,
+               responses[i].overshoot, responses[i].jitter);
+      TEST_MESSAGE(message);
+    }
+    measured = true;
+  }
+  return responses[index];
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_prediction_hides_lag() {
+  // Looking ahead should cut the error while aiming, both against the hand now and after the downstream delay
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.5 * response(0).error_now, response(2).error_now);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.6 * response(0).error_ahead, response(3).error_ahead);
+  // On a steady tilt, the tracker removes the horizon from the lag, to within a sample
+  for (std::size_t i = 1; i < std::size(HORIZONS); i++) {
+    TEST_ASSERT_DOUBLE_WITHIN(traces::TIME_DELTA, response(0).ramp_lag - HORIZONS[i], response(i).ramp_lag);
+  }
+}
+
+void test_prediction_overshoot() {
+  // Without a horizon the tracker barely passes the end of a flick, and with one it passes it by less than the
+  // horizon's worth of the flick's peak speed
+  const double peak_speed = 1.875 * traces::FLICK_SIZE / traces::FLICK_DURATION;
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.05 * traces::FLICK_SIZE, response(0).overshoot);
+  for (std::size_t i = 1; i < std::size(HORIZONS); i++) {
+    TEST_ASSERT_LESS_THAN_DOUBLE(HORIZONS[i] * peak_speed, response(i).overshoot);
+  }
+}
+
+void test_prediction_jitter() {
+  // Extrapolation amplifies noise, but even the longest horizon stays well under a mg per published motion
+  std::size_t longest = std::size(HORIZONS) - 1;
+  TEST_ASSERT_LESS_THAN_DOUBLE(response(longest).jitter, response(0).jitter);
+  TEST_ASSERT_LESS_THAN_DOUBLE(1.0, response(longest).jitter);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_prediction_hides_lag);
+  RUN_TEST(test_prediction_overshoot);
+  RUN_TEST(test_prediction_jitter);
+  return UNITY_END();
+}
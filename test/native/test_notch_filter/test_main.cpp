@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <unity.h>
+
+#include "gauss_filter.h"
+#include "notch_filter.h"
+
+// Smoothing as configured in main.cpp, with and without TREMOR_FILTER, sampled at 225 Hz
+constexpr double TIME_DELTA = 5 / 1125.0;
+constexpr double LONG_STDDEV = 0.025;
+constexpr double SHORT_STDDEV = 0.008;
+constexpr double Z_CUTOFF = 2;
+constexpr double TREMOR_LOW = 8;
+constexpr double TREMOR_HIGH = 12;
+constexpr std::size_t TREMOR_STAGES = 2;
+
+/// @brief Tilt smoothing with an optional tremor notch bank ahead of the bell curve, as smoothAccel() runs it.
+class Smoothing {
+  mvmt::GaussianFilter<double> m_gauss;
+  mvmt::NotchFilterBank<double, TREMOR_STAGES> m_tremor;
+  bool m_notch;
+
+public:
+  Smoothing(double stddev, bool notch)
+      : m_gauss(stddev, Z_CUTOFF, TIME_DELTA, 0.0), m_tremor(TREMOR_LOW, TREMOR_HIGH, TIME_DELTA, 0.0),
+        m_notch(notch) {}
+  double step(double sample) {
+    if (m_notch) {
+      m_tremor.add_measurement(sample);
+      sample = m_tremor.get_current();
+    }
+    m_gauss.add_measurement(sample);
+    return m_gauss.get_current();
+  }
+};
+
+/// @brief Measure a filter's steady-state gain at one frequency, by the RMS of its output against its input.
+/// @return The gain in dB
+double gain_db(double stddev, bool notch, double frequency) {
+  Smoothing filter(stddev, notch);
+  const int settle = 2 / TIME_DELTA, measure = 2 / TIME_DELTA;
+  double in = 0, out = 0;
+  for (int i = 0; i < settle + measure; i++) {
+    double sample = std::sin(2 * M_PI * frequency * i * TIME_DELTA);
+    double output = filter.step(sample);
+    if (i >= settle) {
+      in += sample * sample;
+      out += output * output;
+    }
+  }
+  return 10 * std::log10(out / in);
+}
+
+/// @brief The worst case gain across the tremor band.
+double worst_tremor_gain_db(double stddev, bool notch) {
+  double worst = -INFINITY;
+  for (double frequency = TREMOR_LOW; frequency <= TREMOR_HIGH; frequency += 0.1) {
+    worst = std::max(worst, gain_db(stddev, notch, frequency));
+  }
+  return worst;
+}
+
+/// @brief Measure how far a filter's output trails a ramp of 1 unit per second once settled.
+/// @return The lag in ms
+double ramp_lag_ms(double stddev, bool notch) {
+  Smoothing filter(stddev, notch);
+  double output = 0;
+  const int samples = 2 / TIME_DELTA;
+  for (int i = 0; i < samples; i++) {
+    output = filter.step(i * TIME_DELTA);
+  }
+  return 1000 * ((samples - 1) * TIME_DELTA - output);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_notch_bank_against_gaussian() {
+  struct {
+    const char *name;
+    double stddev;
+    bool notch;
+    double tremor, slow, lag;
+  } rows[] = {{"Gaussian 25 ms", LONG_STDDEV, false}, {"Gaussian 8 ms", SHORT_STDDEV, false},
+              {"notch x2 + Gaussian 8", SHORT_STDDEV, true}};
+  for (auto &row : rows) {
+    row.tremor = worst_tremor_gain_db(row.stddev, row.notch);
+    row.slow = gain_db(row.stddev, row.notch, 4);
+    row.lag = ramp_lag_ms(row.stddev, row.notch);
+    char message[96];
+    snprintf(message, sizeof(message), "%-22s worst 8-12 Hz %5.1f dB, 4 Hz %5.2f dB, ramp lag %4.1f ms", row.name,
+             row.tremor, row.slow, row.lag);
+    TEST_MESSAGE(message);
+  }
+  // The notches stop tremor better than even the long bell curve, while passing deliberate 4 Hz motion better and
+  // lagging a ramp less
+  TEST_ASSERT_LESS_THAN_DOUBLE(rows[0].tremor, rows[2].tremor);
+  TEST_ASSERT_GREATER_THAN_DOUBLE(rows[0].slow, rows[2].slow);
+  TEST_ASSERT_LESS_THAN_DOUBLE(rows[0].lag, rows[2].lag);
+}
+
+void test_gravity_does_not_ring() {
+  // The first sample seeds the bank at rest, so a board that starts out tilted reads its tilt straight away
+  mvmt::NotchFilterBank<Eigen::Vector3d, TREMOR_STAGES> bank(TREMOR_LOW, TREMOR_HIGH, TIME_DELTA,
+                                                             Eigen::Vector3d::Zero());
+  Eigen::Vector3d gravity(120, -340, 930);
+  for (int i = 0; i < 100; i++) {
+    bank.add_measurement(gravity);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, (bank.get_current() - gravity).norm());
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_notch_bank_against_gaussian);
+  RUN_TEST(test_gravity_does_not_ring);
+  return UNITY_END();
+}
@@ -0,0 +1,69 @@
+#include <cstdio>
+#include <unity.h>
+
+#include "../motion_traces.h"
+#include "gauss_filter.h"
+#include "one_euro_filter.h"
+
+// Smoothing as configured in main.cpp: the accelerometer's bell curve, the gyroscope's shorter one, and the One Euro
+// defaults
+constexpr double LONG_STDDEV = 0.025;
+constexpr double SHORT_STDDEV = 0.008;
+constexpr double Z_CUTOFF = 2;
+constexpr double ONE_EURO_MIN_CUTOFF = 1.0;
+constexpr double ONE_EURO_BETA = 0.005;
+constexpr double ONE_EURO_SPEED_CUTOFF = 1.0;
+constexpr double SETTLE_TIME = 1.0; // Seconds skipped at the start of the hold trace while the filters settle
+
+/// @brief How a filter trades jitter for lag on the shared traces.
+struct Response {
+  double jitter;    // RMS error while held still, in mg
+  double ramp_lag;  // Delay behind a steady tilt, in seconds
+  double flick_lag; // Delay behind a flick, in seconds
+};
+
+/// @brief Measure a filter on each trace, building a fresh filter for each so no state carries over.
+template <typename MakeFilter> Response measure(const char *name, MakeFilter make_filter) {
+  auto hold = traces::hold(), ramp = traces::ramp(), flick = traces::flick();
+  auto hold_filter = make_filter(), ramp_filter = make_filter(), flick_filter = make_filter();
+  Response response{traces::rms_error(traces::run(hold_filter, hold), hold, SETTLE_TIME),
+                    traces::ramp_lag(traces::run(ramp_filter, ramp), ramp),
+                    traces::flick_lag(traces::run(flick_filter, flick), flick)};
+  char message[96];
+  snprintf(message, sizeof(message), "%-30s jitter %.2f mg, ramp lag %.1f ms, flick lag %.1f ms", name,
+           response.jitter, response.ramp_lag * 1000, response.flick_lag * 1000);
+  TEST_MESSAGE(message);
+  return response;
+}
+
+Response gaussian(const char *name, double stddev) {
+  return measure(name, [stddev] { return mvmt::GaussianFilter<double>(stddev, Z_CUTOFF, traces::TIME_DELTA, 0.0); });
+}
+
+Response one_euro(const char *name, double min_cutoff, double beta) {
+  return measure(name, [=] {
+    return mvmt::OneEuroFilter<double>(min_cutoff, beta, ONE_EURO_SPEED_CUTOFF, traces::TIME_DELTA, 0.0);
+  });
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_one_euro_against_gaussian() {
+  auto long_gaussian = gaussian("Gaussian, 25 ms", LONG_STDDEV);
+  auto short_gaussian = gaussian("Gaussian, 8 ms", SHORT_STDDEV);
+  auto defaults = one_euro("One Euro, 1.0 Hz, beta 0.005", ONE_EURO_MIN_CUTOFF, ONE_EURO_BETA);
+  one_euro("One Euro, 0.5 Hz, beta 0.002", 0.5, 0.002);
+  one_euro("One Euro, 1.0 Hz, beta 0.01", 1.0, 0.01);
+  // The defaults should hold still better than the long bell curve while keeping up with the short one
+  TEST_ASSERT_LESS_THAN_DOUBLE(long_gaussian.jitter, defaults.jitter);
+  TEST_ASSERT_LESS_THAN_DOUBLE(short_gaussian.jitter, defaults.jitter);
+  TEST_ASSERT_LESS_THAN_DOUBLE(short_gaussian.ramp_lag + traces::TIME_DELTA, defaults.ramp_lag);
+  TEST_ASSERT_LESS_THAN_DOUBLE(short_gaussian.flick_lag + traces::TIME_DELTA, defaults.flick_lag);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_one_euro_against_gaussian);
+  return UNITY_END();
+}
@@ -0,0 +1,65 @@
+#include <cmath>
+#include <unity.h>
+
+#include "orientation.h"
+
+/// @brief Encode a unit quaternion's vector part as the DMP reports it, with 30 fractional bits.
+void to_q30(const Eigen::Quaterniond &q, std::int32_t &x, std::int32_t &y, std::int32_t &z) {
+  x = std::lround(q.x() * (1 << 30));
+  y = std::lround(q.y() * (1 << 30));
+  z = std::lround(q.z() * (1 << 30));
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_quaternion_from_q30_restores_scalar_part() {
+  Eigen::Quaterniond expected(Eigen::AngleAxisd(1.2, Eigen::Vector3d(1, -2, 0.5).normalized()));
+  std::int32_t x, y, z;
+  to_q30(expected, x, y, z);
+  Eigen::Quaterniond actual = mvmt::quaternion_from_q30<double>(x, y, z);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-8, expected.w(), actual.w());
+  TEST_ASSERT_DOUBLE_WITHIN(1e-8, 1.0, actual.norm());
+}
+
+void test_quaternion_from_q30_clamps_rounding() {
+  // A half turn has no scalar part, and rounding the vector part can make it slightly longer than one
+  std::int32_t over_one = (1 << 30) + 2;
+  Eigen::Quaternionf q = mvmt::quaternion_from_q30<float>(over_one, 0, 0);
+  TEST_ASSERT_TRUE(std::isfinite(q.w()));
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, q.w());
+}
+
+void test_rotation_between_recovers_small_yaw() {
+  Eigen::Quaterniond from(Eigen::AngleAxisd(0.7, Eigen::Vector3d(0.3, 1, -0.2).normalized()));
+  Eigen::Quaterniond to = from * Eigen::Quaterniond(Eigen::AngleAxisd(0.01, Eigen::Vector3d::UnitZ()));
+  Eigen::Vector3d rotation = mvmt::rotation_between(from, to);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, rotation.x());
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, rotation.y());
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.01, rotation.z());
+}
+
+void test_rotation_between_takes_short_way_across_sign_flip() {
+  // The DMP may report either sign of the same orientation, which must not read as a full turn
+  Eigen::Quaterniond from(Eigen::AngleAxisd(3.1, Eigen::Vector3d::UnitY()));
+  Eigen::Quaterniond to = from * Eigen::Quaterniond(Eigen::AngleAxisd(0.01, Eigen::Vector3d::UnitZ()));
+  to.coeffs() = -to.coeffs();
+  Eigen::Vector3d rotation = mvmt::rotation_between(from, to);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.01, rotation.z());
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.01, rotation.norm());
+}
+
+void test_rotation_between_identical_orientations_is_zero() {
+  Eigen::Quaternionf q(Eigen::AngleAxisf(0.4f, Eigen::Vector3f::UnitX()));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-7, 0.0, mvmt::rotation_between(q, q).norm());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_quaternion_from_q30_restores_scalar_part);
+  RUN_TEST(test_quaternion_from_q30_clamps_rounding);
+  RUN_TEST(test_rotation_between_recovers_small_yaw);
+  RUN_TEST(test_rotation_between_takes_short_way_across_sign_flip);
+  RUN_TEST(test_rotation_between_identical_orientations_is_zero);
+  return UNITY_END();
+}
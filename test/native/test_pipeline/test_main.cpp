@@ -0,0 +1,197 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+#include <vector>
+
+#include "bias_estimator.h"
+#include "fixed_point.h"
+#include "gauss_filter.h"
+#include "mouse_curve.h"
+#include "pipeline.h"
+
+// Gyroscope smoothing and bias learning as configured in main.cpp, sampled at 225 Hz
+constexpr double TIME_DELTA = 5 / 1125.0;
+constexpr double GYRO_STDDEV = 0.008;
+constexpr double GYRO_Z_CUTOFF = 2;
+constexpr float STILL_THRESHOLD = 0.035;
+constexpr float MAX_BIAS = 0.2;
+constexpr float STILL_TIME = 0.25;
+constexpr float BIAS_TIME_CONSTANT = 2.0;
+// Cursor mapping as configured in main.cpp for fixed-point motion, where tilt is a fraction of the 2000 mg full scale
+constexpr double ACCEL_FULL_SCALE = 2000;
+constexpr double MOUSE_SENSITIVITY = 0.003 * ACCEL_FULL_SCALE;
+constexpr double CURSOR_DEADZONE = 0.015;
+constexpr std::size_t SAMPLES = 5000;
+
+using estimator_t = mvmt::BiasEstimator<Eigen::Vector3f>;
+
+estimator_t make_estimator() {
+  return estimator_t(STILL_THRESHOLD, MAX_BIAS, STILL_TIME, BIAS_TIME_CONSTANT, TIME_DELTA, Eigen::Vector3f::Zero());
+}
+
+/// @brief A gyroscope trace in rad/s: rests, with a bias to learn, between turns of the board.
+std::vector<Eigen::Vector3f> make_gyro_trace() {
+  std::mt19937 generator(20948);
+  std::normal_distribution<float> noise(0.0f, 0.003f);
+  std::vector<Eigen::Vector3f> trace;
+  trace.reserve(SAMPLES);
+  const Eigen::Vector3f bias(0.02, -0.03, 0.08);
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    double t = i * TIME_DELTA;
+    float turn = std::fmod(t, 4.0) < 2.0 ? 0.0f : static_cast<float>(std::sin(3 * t));
+    trace.push_back(bias + Eigen::Vector3f(turn, 0.5f * turn, 0) +
+                    Eigen::Vector3f(noise(generator), noise(generator), noise(generator)));
+  }
+  return trace;
+}
+
+/// @brief Random tilts over the accelerometer's range, as fixed-point fractions of full scale.
+std::vector<mvmt::Q31> make_tilts() {
+  std::mt19937 generator(1125);
+  std::uniform_real_distribution<double> fraction(-1, 1);
+  std::vector<mvmt::Q31> tilts;
+  tilts.reserve(SAMPLES);
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    tilts.emplace_back(fraction(generator));
+  }
+  return tilts;
+}
+
+const auto PROFILE = mvmt::CurveTable<mvmt::Q16, 64>::sample([](double x) { return mvmt::mouse_curve(x); },
+                                                             MOUSE_SENSITIVITY);
+
+/// @brief The cursor mapping wired by hand: scale, deadzone and acceleration profile.
+float map_by_hand(mvmt::Q31 tilt, mvmt::DeadzoneStage<mvmt::Q16> &deadzone) {
+  deadzone.add_measurement(mvmt::Q16(tilt) * mvmt::Q16(MOUSE_SENSITIVITY));
+  return static_cast<float>(PROFILE.evaluate(deadzone.get_current()));
+}
+
+/// @brief Time how long it takes to pass every input of a trace through a step.
+/// @return The mean time per sample in nanoseconds
+template <typename T, typename Step> double time_per_sample(const std::vector<T> &trace, Step step) {
+  auto start = std::chrono::steady_clock::now();
+  for (const T &sample : trace) {
+    step(sample);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / trace.size();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_gyro_pipeline_matches_hand_wiring() {
+  estimator_t hand_bias = make_estimator(), pipeline_bias = make_estimator();
+  mvmt::GaussianFilter<Eigen::Vector3f> hand_filter(GYRO_STDDEV, GYRO_Z_CUTOFF, TIME_DELTA, Eigen::Vector3f::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3f> pipeline_filter(GYRO_STDDEV, GYRO_Z_CUTOFF, TIME_DELTA,
+                                                        Eigen::Vector3f::Zero());
+  mvmt::BiasRemovalStage<estimator_t, Eigen::Vector3f> debias(pipeline_bias, Eigen::Vector3f::Zero());
+  mvmt::Pipeline pipeline(debias, pipeline_filter);
+  for (const Eigen::Vector3f &rate : make_gyro_trace()) {
+    hand_bias.add_measurement(rate);
+    hand_filter.add_measurement(hand_bias.remove(rate));
+    pipeline.add_measurement(rate);
+    // Exactly the same operations in the same order, so exactly the same output
+    Eigen::Vector3f expected = hand_filter.get_current(), actual = pipeline.get_current();
+    TEST_ASSERT_TRUE(expected == actual);
+  }
+  // The estimator is shared rather than copied, so calibration can still reach it
+  TEST_ASSERT_TRUE(pipeline_bias.get_current().isApprox(hand_bias.get_current()));
+  TEST_ASSERT_FALSE(pipeline_bias.get_current().isZero());
+}
+
+void test_deadzone_edges() {
+  mvmt::DeadzoneStage<float> deadzone(0.5f);
+  const float inputs[] = {0.0f, 0.25f, 0.5f, 0.5001f, 1.0f, 3.0f};
+  const float outputs[] = {0.0f, 0.0f, 0.0f, 0.0001f, 0.5f, 2.5f};
+  for (std::size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+    deadzone.add_measurement(inputs[i]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, outputs[i], deadzone.get_current());
+    deadzone.add_measurement(-inputs[i]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, -outputs[i], deadzone.get_current());
+  }
+  // In fixed point the threshold itself is still inside, and the next value up leaves by exactly one step
+  mvmt::DeadzoneStage<mvmt::Q16> fixed{mvmt::Q16(CURSOR_DEADZONE)};
+  mvmt::Q16 edge(CURSOR_DEADZONE);
+  fixed.add_measurement(edge);
+  TEST_ASSERT_EQUAL(0, fixed.get_current().raw);
+  fixed.add_measurement(mvmt::Q16::from_raw(edge.raw + 1));
+  TEST_ASSERT_EQUAL(1, fixed.get_current().raw);
+  fixed.add_measurement(mvmt::Q16::from_raw(-edge.raw - 1));
+  TEST_ASSERT_EQUAL(-1, fixed.get_current().raw);
+}
+
+void test_fixed_cursor_pipeline_matches_hand_wiring() {
+  auto scale =
+      mvmt::map_stage<mvmt::Q31>([](mvmt::Q31 tilt) { return mvmt::Q16(tilt) * mvmt::Q16(MOUSE_SENSITIVITY); });
+  mvmt::DeadzoneStage<mvmt::Q16> deadzone{mvmt::Q16(CURSOR_DEADZONE)}, hand_deadzone{mvmt::Q16(CURSOR_DEADZONE)};
+  auto profile =
+      mvmt::map_stage<mvmt::Q16>([](mvmt::Q16 value) { return static_cast<float>(PROFILE.evaluate(value)); });
+  mvmt::Pipeline pipeline(scale, deadzone, profile);
+  // A pipeline is itself a stage, so wrapping it changes nothing
+  mvmt::Pipeline nested(pipeline);
+  for (mvmt::Q31 tilt : make_tilts()) {
+    nested.add_measurement(tilt);
+    TEST_ASSERT_TRUE(map_by_hand(tilt, hand_deadzone) == nested.get_current());
+  }
+  // Level tilts inside the deadzone don't move the cursor at all
+  nested.add_measurement(mvmt::Q31(4.9 / ACCEL_FULL_SCALE));
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, nested.get_current());
+  nested.add_measurement(mvmt::Q31(-5.1 / ACCEL_FULL_SCALE));
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.0, nested.get_current());
+}
+
+void test_pipeline_benchmark() {
+  const auto rates = make_gyro_trace();
+  const auto tilts = make_tilts();
+  estimator_t hand_bias = make_estimator(), pipeline_bias = make_estimator();
+  mvmt::GaussianFilter<Eigen::Vector3f> hand_filter(GYRO_STDDEV, GYRO_Z_CUTOFF, TIME_DELTA, Eigen::Vector3f::Zero());
+  mvmt::GaussianFilter<Eigen::Vector3f> pipeline_filter(GYRO_STDDEV, GYRO_Z_CUTOFF, TIME_DELTA,
+                                                        Eigen::Vector3f::Zero());
+  mvmt::BiasRemovalStage<estimator_t, Eigen::Vector3f> debias(pipeline_bias, Eigen::Vector3f::Zero());
+  mvmt::Pipeline gyro(debias, pipeline_filter);
+  Eigen::Vector3f rate_sink = Eigen::Vector3f::Zero();
+  double gyro_hand = time_per_sample(rates, [&](const Eigen::Vector3f &rate) {
+    hand_bias.add_measurement(rate);
+    hand_filter.add_measurement(hand_bias.remove(rate));
+    rate_sink += hand_filter.get_current();
+  });
+  double gyro_pipeline = time_per_sample(rates, [&](const Eigen::Vector3f &rate) {
+    gyro.add_measurement(rate);
+    rate_sink += gyro.get_current();
+  });
+
+  auto scale =
+      mvmt::map_stage<mvmt::Q31>([](mvmt::Q31 tilt) { return mvmt::Q16(tilt) * mvmt::Q16(MOUSE_SENSITIVITY); });
+  mvmt::DeadzoneStage<mvmt::Q16> deadzone{mvmt::Q16(CURSOR_DEADZONE)}, hand_deadzone{mvmt::Q16(CURSOR_DEADZONE)};
+  auto profile =
+      mvmt::map_stage<mvmt::Q16>([](mvmt::Q16 value) { return static_cast<float>(PROFILE.evaluate(value)); });
+  mvmt::Pipeline cursor(scale, deadzone, profile);
+  float cursor_sink = 0;
+  double cursor_hand =
+      time_per_sample(tilts, [&](mvmt::Q31 tilt) { cursor_sink += map_by_hand(tilt, hand_deadzone); });
+  double cursor_pipeline = time_per_sample(tilts, [&](mvmt::Q31 tilt) {
+    cursor.add_measurement(tilt);
+    cursor_sink += cursor.get_current();
+  });
+  // Keep the outputs observable so the loops can't be optimized away
+  TEST_ASSERT_TRUE(std::isfinite(rate_sink.sum()) && std::isfinite(cursor_sink));
+  char message[96];
+  snprintf(message, sizeof(message), "gyro bias + Gaussian: by hand %.1f ns/sample, pipeline %.1f ns/sample",
+           gyro_hand, gyro_pipeline);
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "Q16 cursor: by hand %.1f ns/sample, pipeline %.1f ns/sample", cursor_hand,
+           cursor_pipeline);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_gyro_pipeline_matches_hand_wiring);
+  RUN_TEST(test_deadzone_edges);
+  RUN_TEST(test_fixed_cursor_pipeline_matches_hand_wiring);
+  RUN_TEST(test_pipeline_benchmark);
+  return UNITY_END();
+}
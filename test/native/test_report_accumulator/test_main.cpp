@@ -0,0 +1,87 @@
+#include <cmath>
+#include <unity.h>
+
+#include "report_accumulator.h"
+
+// Backlog cap as configured in main.cpp: twice the 4 reports sent for one sample
+constexpr int MAX_REPORTS = 8;
+
+void setUp() {}
+void tearDown() {}
+
+void test_slow_movement_adds_up() {
+  mvmt::ReportAccumulator accumulator(MAX_REPORTS);
+  int sent = 0;
+  for (int i = 0; i < 1000; i++) {
+    accumulator.add(0.013f, 0, 0, 0);
+    while (accumulator.ready()) {
+      sent += accumulator.take().x;
+    }
+  }
+  TEST_ASSERT_EQUAL(13, sent);
+}
+
+void test_fast_movement_is_split_without_wrapping() {
+  mvmt::ReportAccumulator accumulator(MAX_REPORTS);
+  accumulator.add(300, -1000, 2, 0);
+  int x = 0, y = 0, wheel = 0, reports = 0;
+  while (accumulator.ready()) {
+    mvmt::MouseReport report = accumulator.take();
+    x += report.x;
+    y += report.y;
+    wheel += report.wheel;
+    reports++;
+  }
+  // Reports carry at most 127 counts per axis, so the y movement needs 8 of them
+  TEST_ASSERT_EQUAL(8, reports);
+  TEST_ASSERT_EQUAL(300, x);
+  TEST_ASSERT_EQUAL(-1000, y);
+  TEST_ASSERT_EQUAL(2, wheel);
+}
+
+void test_backlog_is_capped() {
+  mvmt::ReportAccumulator accumulator(MAX_REPORTS);
+  accumulator.add(0, 1500, 0, 0);
+  accumulator.add(0, 1500, 0, 0);
+  int y = 0, reports = 0;
+  while (accumulator.ready()) {
+    y += accumulator.take().y;
+    reports++;
+  }
+  // Movement beyond what 8 reports can carry is dropped rather than left to lag behind
+  TEST_ASSERT_EQUAL(MAX_REPORTS, reports);
+  TEST_ASSERT_EQUAL(MAX_REPORTS * mvmt::ReportAccumulator::REPORT_LIMIT, y);
+}
+
+void test_remainder_keeps_its_sign() {
+  mvmt::ReportAccumulator accumulator(MAX_REPORTS);
+  accumulator.add(-2.75f, 0.5f, 0, 0);
+  mvmt::MouseReport report = accumulator.take();
+  TEST_ASSERT_EQUAL(-2, report.x);
+  TEST_ASSERT_EQUAL(0, report.y);
+  TEST_ASSERT_FALSE(accumulator.ready());
+  // The held fractions complete a count on each axis without overshooting
+  accumulator.add(-0.25f, 0.5f, 0, 0);
+  report = accumulator.take();
+  TEST_ASSERT_EQUAL(-1, report.x);
+  TEST_ASSERT_EQUAL(1, report.y);
+}
+
+void test_clear_drops_pending_movement() {
+  mvmt::ReportAccumulator accumulator(MAX_REPORTS);
+  accumulator.add(0.9f, 40, 0, -3);
+  accumulator.clear();
+  TEST_ASSERT_FALSE(accumulator.ready());
+  accumulator.add(0.2f, 0, 0, 0);
+  TEST_ASSERT_FALSE(accumulator.ready());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_slow_movement_adds_up);
+  RUN_TEST(test_fast_movement_is_split_without_wrapping);
+  RUN_TEST(test_backlog_is_capped);
+  RUN_TEST(test_remainder_keeps_its_sign);
+  RUN_TEST(test_clear_drops_pending_movement);
+  return UNITY_END();
+}
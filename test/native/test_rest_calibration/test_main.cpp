@@ -0,0 +1,122 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+
+#include "rest_calibration.h"
+
+// Rest calibration as configured in main.cpp, fed raw accelerometer counts and gyroscope rates at 225 Hz
+constexpr float TIME_DELTA = 5 / 1125.0;
+constexpr float COUNTS_PER_MG = 32768 / 2000.0;
+constexpr float ACCEL_NOISE = 10 * COUNTS_PER_MG;
+constexpr float GYRO_NOISE = 0.02;
+constexpr float STILL_TIME = 1.0;
+const Eigen::Vector3f ACCEL_BIAS(20, -20, 20);     // Accelerometer offset in mg
+const Eigen::Vector3f GYRO_BIAS(0.02, -0.03, 0.08); // Zero-rate offset in rad/s
+
+/// @brief An IMU resting at a tilt, with offsets and noise, that can be shaken to count as moving.
+class Imu {
+  std::mt19937 m_generator{20948};
+  std::normal_distribution<float> m_accel_noise{0.0f, 3.0f};
+  std::normal_distribution<float> m_gyro_noise{0.0f, 0.003f};
+
+public:
+  Eigen::Vector3f gravity; // True gravity in board coordinates, in mg
+
+  explicit Imu(const Eigen::Vector3f &gravity) : gravity(gravity) {}
+  /// @brief Read the accelerometer in counts and the gyroscope in rad/s, while shaken by a given acceleration and rate.
+  void read(Eigen::Vector3f &accel, Eigen::Vector3f &gyro, float shake = 0) {
+    Eigen::Vector3f noise(m_accel_noise(m_generator), m_accel_noise(m_generator), m_accel_noise(m_generator));
+    accel = (gravity + ACCEL_BIAS + noise + Eigen::Vector3f::Constant(100 * shake)) * COUNTS_PER_MG;
+    Eigen::Vector3f drift(m_gyro_noise(m_generator), m_gyro_noise(m_generator), m_gyro_noise(m_generator));
+    gyro = GYRO_BIAS + drift + Eigen::Vector3f::Constant(shake);
+  }
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_calibration_waits_for_stillness() {
+  mvmt::RestCalibrator calibrator(ACCEL_NOISE, GYRO_NOISE, STILL_TIME, TIME_DELTA);
+  Imu imu(1000 * Eigen::Vector3f(0, std::sin(0.3f), std::cos(0.3f)));
+  Eigen::Vector3f accel, gyro;
+  calibrator.start();
+  // A second of the hand still settling from the press, then rest
+  const int moving = 1 / TIME_DELTA, needed = STILL_TIME / TIME_DELTA;
+  for (int i = 0; i < moving; i++) {
+    imu.read(accel, gyro, std::sin(i * 0.2f));
+    TEST_ASSERT_FALSE(calibrator.add_measurement(accel, gyro));
+  }
+  int finished = -1;
+  for (int i = 0; i < 2 * needed && finished < 0; i++) {
+    imu.read(accel, gyro);
+    if (calibrator.add_measurement(accel, gyro)) {
+      finished = i + 1;
+    }
+  }
+  TEST_ASSERT_FALSE(calibrator.active());
+  // The moving samples are dropped within a handful of samples of settling, so the calibration finishes about a still
+  // time after the board comes to rest
+  TEST_ASSERT_GREATER_THAN(needed - 1, finished);
+  TEST_ASSERT_LESS_THAN(needed + 9, finished);
+
+  const mvmt::RestCalibration &calibration = calibrator.get_current();
+  // Held on in the calibrated pose, readings have no tilt left beyond their noise
+  Eigen::Vector3f resting = Eigen::Vector3f::Zero();
+  for (int i = 0; i < needed; i++) {
+    imu.read(accel, gyro);
+    resting += accel / needed;
+  }
+  Eigen::Vector3f levelled = calibration.level_frame() * resting / COUNTS_PER_MG;
+  float bias_error = (calibration.gyro_bias - GYRO_BIAS).norm();
+  char message[112];
+  snprintf(message, sizeof(message),
+           "finished %d samples after rest, levelled to (%.2f, %.2f) mg, bias error %.2f mrad/s", finished,
+           levelled.x(), levelled.y(), 1000 * bias_error);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_FLOAT_WITHIN(1.0, 0.0, levelled.x());
+  TEST_ASSERT_FLOAT_WITHIN(1.0, 0.0, levelled.y());
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.001, bias_error);
+}
+
+void test_level_frame_is_a_rotation() {
+  // Tilted forward, and lying on its side where the x axis has no heading to keep
+  const Eigen::Vector3f rests[] = {Eigen::Vector3f(0.1, 0.3, 0.95), Eigen::Vector3f(0.98, 0.1, 0.15)};
+  for (const Eigen::Vector3f &gravity : rests) {
+    mvmt::RestCalibration calibration{gravity, Eigen::Vector3f::Zero()};
+    Eigen::Matrix3f frame = calibration.level_frame();
+    TEST_ASSERT_TRUE((frame * frame.transpose()).isIdentity(1e-5f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0, frame.determinant());
+    Eigen::Vector3f levelled = frame * gravity.normalized();
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0, levelled.z());
+  }
+  // Upright, the board's x axis keeps pointing forward
+  mvmt::RestCalibration upright{Eigen::Vector3f(0, 0.3, 0.95), Eigen::Vector3f::Zero()};
+  TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0, upright.level_frame()(0, 0));
+}
+
+void test_running_stats_keep_precision() {
+  // Small spread around a large mean, as a resting axis reads in counts, is where a float sum of squares cancels away
+  mvmt::RunningStats<Eigen::Vector3f> stats(Eigen::Vector3f::Zero());
+  std::mt19937 generator(1125);
+  std::normal_distribution<float> reading(16384, 10);
+  double sum = 0, sum_squares = 0;
+  const int count = 200000;
+  for (int i = 0; i < count; i++) {
+    float sample = reading(generator);
+    stats.add_measurement(Eigen::Vector3f::Constant(sample));
+    sum += sample;
+    sum_squares += double(sample) * sample;
+  }
+  double mean = sum / count, stddev = std::sqrt((sum_squares - sum * mean) / (count - 1));
+  TEST_ASSERT_FLOAT_WITHIN(0.5, mean, stats.mean().x());
+  TEST_ASSERT_FLOAT_WITHIN(0.1, stddev, std::sqrt(stats.variance().x()));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_calibration_waits_for_stillness);
+  RUN_TEST(test_level_frame_is_a_rotation);
+  RUN_TEST(test_running_stats_keep_precision);
+  return UNITY_END();
+}
@@ -0,0 +1,102 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+
+#include "../motion_traces.h"
+#include "stillness_detector.h"
+
+// Stillness detection as configured in main.cpp, fed raw accelerometer counts and gyroscope rates
+constexpr float COUNTS_PER_MG = 32768 / 2000.0;
+constexpr float ACCEL_NOISE = 6 * COUNTS_PER_MG;
+constexpr float GYRO_NOISE = 0.01;
+constexpr float WINDOW_TIME = 0.2;
+constexpr float STILL_TIME = 0.5;
+constexpr double DESK_TIME = 2.0; // Seconds the board lies on the desk before it is picked up
+
+/// @brief Feeds a tilt trace to a detector as the IMU would see it: the trace's measured tilt on the x axis, the rest of
+/// gravity on the z axis, and the rate of tilting on the y axis of the gyroscope, each with its own noise.
+class Replay {
+  std::mt19937 m_generator{1125};
+  std::normal_distribution<float> m_accel_noise{0.0f, traces::NOISE};
+  std::normal_distribution<float> m_gyro_noise{0.0f, 0.003f};
+
+public:
+  mvmt::StillnessDetector detector{ACCEL_NOISE, GYRO_NOISE, WINDOW_TIME, STILL_TIME, traces::TIME_DELTA};
+
+  /// @brief Feed one sample of a trace to the detector.
+  /// @return Whether the board is still after the sample
+  bool step(const traces::Trace &trace, std::size_t i) {
+    double tilt = trace.truth[i];
+    // A tilt of 1000 mg is a quarter turn, so small tilts turn the board by about a mrad per mg
+    double rate = i > 0 ? (tilt - trace.truth[i - 1]) / traces::TIME_DELTA / 1000 : 0;
+    Eigen::Vector3f accel(trace.measured[i], m_accel_noise(m_generator),
+                          std::sqrt(1e6 - tilt * tilt) + m_accel_noise(m_generator));
+    Eigen::Vector3f gyro(m_gyro_noise(m_generator), rate + m_gyro_noise(m_generator), m_gyro_noise(m_generator));
+    return detector.add_measurement(accel * COUNTS_PER_MG, gyro);
+  }
+};
+
+/// @brief The board lying on a desk, flicked to a new tilt, and then left lying at that tilt.
+traces::Trace pick_up() {
+  return traces::make_trace(
+      [](double t) {
+        return traces::FLICK_SIZE * traces::minimum_jerk((t - DESK_TIME) / traces::FLICK_DURATION);
+      },
+      DESK_TIME + 4.0);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_no_stillness_while_held() {
+  // Aiming in the hand never stops long enough, or trembles too little, to count as lying still
+  const auto trace = traces::reaches(60);
+  Replay replay;
+  for (std::size_t i = 0; i < trace.truth.size(); i++) {
+    TEST_ASSERT_FALSE(replay.step(trace, i));
+  }
+}
+
+void test_stillness_ends_on_first_moving_sample() {
+  const auto trace = pick_up();
+  Replay replay;
+  std::size_t i = 0;
+  for (; trace.truth[i] == trace.truth[0]; i++) {
+    replay.step(trace, i);
+  }
+  TEST_ASSERT_TRUE(replay.detector.still());
+  // The variance would take a while to build up, so it is the single sample off the mean that has to end stillness
+  TEST_ASSERT_FALSE(replay.step(trace, i));
+  // and the rest of the flick must not be frozen either
+  for (i++; trace.truth[i] != trace.truth[i - 1]; i++) {
+    TEST_ASSERT_FALSE(replay.step(trace, i));
+  }
+}
+
+void test_stillness_resumes_after_setting_down() {
+  const auto trace = pick_up();
+  Replay replay;
+  double resumed = INFINITY;
+  const double settled = DESK_TIME + traces::FLICK_DURATION;
+  for (std::size_t i = 0; i < trace.truth.size(); i++) {
+    if (replay.step(trace, i) && i * traces::TIME_DELTA > settled) {
+      resumed = i * traces::TIME_DELTA - settled;
+      break;
+    }
+  }
+  char message[64];
+  snprintf(message, sizeof(message), "still again %.2f s after the flick", resumed);
+  TEST_MESSAGE(message);
+  // The flick's spread has to decay out of the window, and then the board has to stay quiet for the still time
+  TEST_ASSERT_GREATER_THAN_DOUBLE(STILL_TIME, resumed);
+  TEST_ASSERT_LESS_THAN_DOUBLE(3.0, resumed);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_stillness_while_held);
+  RUN_TEST(test_stillness_ends_on_first_moving_sample);
+  RUN_TEST(test_stillness_resumes_after_setting_down);
+  return UNITY_END();
+}
@@ -0,0 +1,220 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+#include <vector>
+
+#include "tap_detector.h"
+
+// Tap detection as configured in main.cpp, fed raw accelerometer counts
+constexpr float COUNTS_PER_MG = 32768 / 2000.0;
+constexpr float THRESHOLD = 400 * COUNTS_PER_MG;
+constexpr float SHOCK_TIME = 0.02;
+constexpr float QUIET_TIME = 0.02;
+constexpr float DOUBLE_TIME = 0.2;
+constexpr float BASELINE_TIME = 0.1;
+constexpr double DLPF_CUTOFF = 50;    // On-chip low-pass filter of the balanced profile, in Hz
+constexpr double EVENT_SPACING = 1.0; // Seconds between the start of one tap, double tap or flick and the next
+constexpr int EVENTS = 20;            // Taps, double taps and flicks each
+constexpr double DOUBLE_GAP = 0.12;   // Seconds between the two knocks of a double tap
+
+enum class Event { TAP, DOUBLE_TAP, FLICK };
+
+/// @brief A session of knocks on the board and flicks of it, as the accelerometer reads it: a knock is a 1.5 g, 6 ms
+/// spike ringing at 120 Hz, and a flick is a 700 mg swing over 120 ms, all on top of slow sway and hand tremor.
+struct Session {
+  std::vector<Eigen::Vector3f> samples; // Accelerometer readings in counts
+  std::vector<Event> events;            // What happened, in order
+  std::vector<std::size_t> starts;      // Sample at which each knock or flick began
+  std::vector<std::size_t> owners;      // Index into events of each start, so a double tap owns two
+};
+
+double knock(double t) {
+  if (t < 0)
+    return 0;
+  if (t < 0.006)
+    return 1500 * std::sin(M_PI * t / 0.006);
+  return 300 * std::exp(-(t - 0.006) / 0.008) * std::sin(2 * M_PI * 120 * (t - 0.006));
+}
+
+double flick(double t) {
+  return t < 0 || t > 0.12 ? 0 : 700 * 0.5 * (1 - std::cos(2 * M_PI * t / 0.12));
+}
+
+Session make_session(double time_delta) {
+  std::mt19937 generator(20948);
+  std::normal_distribution<double> noise(0.0, 3.0);
+  Session session;
+  for (int i = 0; i < EVENTS; i++) {
+    session.events.insert(session.events.end(), {Event::TAP, Event::DOUBLE_TAP, Event::FLICK});
+  }
+  const double duration = (session.events.size() + 1) * EVENT_SPACING;
+  const double smoothing = 1 - std::exp(-2 * M_PI * DLPF_CUTOFF * time_delta);
+  Eigen::Vector3d filtered(0, 0, 1000);
+  for (std::size_t e = 0; e < session.events.size(); e++) {
+    session.starts.push_back(static_cast<std::size_t>(std::ceil((e + 1) * EVENT_SPACING / time_delta)));
+    session.owners.push_back(e);
+    if (session.events[e] == Event::DOUBLE_TAP) {
+      double second = (e + 1) * EVENT_SPACING + DOUBLE_GAP;
+      session.starts.push_back(static_cast<std::size_t>(std::ceil(second / time_delta)));
+      session.owners.push_back(e);
+    }
+  }
+  for (std::size_t i = 0; i * time_delta < duration; i++) {
+    double t = i * time_delta;
+    Eigen::Vector3d mg(150 * std::sin(2 * M_PI * 0.3 * t) + 20 * std::sin(2 * M_PI * 9 * t),
+                       150 * std::cos(2 * M_PI * 0.2 * t), 1000);
+    for (std::size_t e = 0; e < session.events.size(); e++) {
+      double since = t - (e + 1) * EVENT_SPACING;
+      switch (session.events[e]) {
+      case Event::TAP:
+        mg.z() += knock(since);
+        break;
+      case Event::DOUBLE_TAP:
+        mg.z() += knock(since) + knock(since - DOUBLE_GAP);
+        break;
+      case Event::FLICK:
+        mg.x() += flick(since);
+        break;
+      }
+    }
+    filtered += smoothing * (mg + Eigen::Vector3d(noise(generator), noise(generator), noise(generator)) - filtered);
+    session.samples.push_back((filtered * COUNTS_PER_MG).cast<float>());
+  }
+  return session;
+}
+
+/// @brief What a detector made of a session.
+struct Outcome {
+  int singles = 0;
+  int doubles = 0;
+  int flick_clicks = 0;            // Taps reported while or just after the board was flicked
+  std::size_t worst_single = 0;    // Longest time from a knock to its single tap's report, in samples
+  std::size_t worst_double = 0;    // Longest time from a double tap's second knock to its report, in samples
+  std::size_t worst_back_date = 0; // Largest difference between a reported age and the measured latency, in samples
+};
+
+Outcome run(const Session &session, mvmt::TapDetector &detector) {
+  Outcome outcome;
+  for (std::size_t i = 0; i < session.samples.size(); i++) {
+    mvmt::Tap tap = detector.add_measurement(session.samples[i]);
+    if (tap == mvmt::Tap::NONE)
+      continue;
+    // The latest knock begun by now is the one that was reported, or the second knock of a double tap
+    std::size_t knock = 0;
+    while (knock + 1 < session.starts.size() && session.starts[knock + 1] <= i) {
+      knock++;
+    }
+    std::size_t event = session.owners[knock];
+    if (session.events[event] == Event::FLICK) {
+      outcome.flick_clicks++;
+      continue;
+    }
+    std::size_t latency = i - session.starts[knock];
+    if (tap == mvmt::Tap::DOUBLE) {
+      outcome.doubles++;
+      outcome.worst_double = std::max(outcome.worst_double, latency);
+    } else {
+      outcome.singles++;
+      outcome.worst_single = std::max(outcome.worst_single, latency);
+    }
+    // The reported age back-dates the click to the spike, which the low-pass filter delays only a little
+    TEST_ASSERT_TRUE(detector.reported_age() <= latency);
+    outcome.worst_back_date = std::max(outcome.worst_back_date, latency - detector.reported_age());
+  }
+  return outcome;
+}
+
+mvmt::TapDetector make_detector(float double_time, double time_delta) {
+  return mvmt::TapDetector(THRESHOLD, SHOCK_TIME, QUIET_TIME, double_time, BASELINE_TIME, time_delta);
+}
+
+void report(const char *name, const Outcome &outcome, const mvmt::TapDetector &detector, double time_delta) {
+  char message[112];
+  snprintf(message, sizeof(message), "%s: %d single, %d double, %d flick clicks", name, outcome.singles,
+           outcome.doubles, outcome.flick_clicks);
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "  worst single latency %.1f ms (bound %.1f ms)",
+           1000 * outcome.worst_single * time_delta, 1000 * detector.latency(mvmt::Tap::SINGLE) * time_delta);
+  TEST_MESSAGE(message);
+  if (outcome.doubles) {
+    snprintf(message, sizeof(message), "  worst double latency %.1f ms (bound %.1f ms)",
+             1000 * outcome.worst_double * time_delta, 1000 * detector.latency(mvmt::Tap::DOUBLE) * time_delta);
+    TEST_MESSAGE(message);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_taps_click_within_bound() {
+  // Without double taps, every knock is a single tap of its own
+  for (double time_delta : {5 / 1125.0, 2 / 1125.0}) {
+    const Session session = make_session(time_delta);
+    mvmt::TapDetector detector = make_detector(0, time_delta);
+    Outcome outcome = run(session, detector);
+    report(time_delta > 0.004 ? "225 Hz" : "562.5 Hz", outcome, detector, time_delta);
+    TEST_ASSERT_EQUAL(3 * EVENTS, outcome.singles);
+    TEST_ASSERT_EQUAL(0, outcome.doubles);
+    TEST_ASSERT_EQUAL(0, outcome.flick_clicks);
+    TEST_ASSERT_TRUE(outcome.worst_single <= detector.latency(mvmt::Tap::SINGLE));
+    TEST_ASSERT_TRUE(outcome.worst_back_date <= 2);
+  }
+}
+
+void test_double_taps_click_within_bound() {
+  constexpr double time_delta = 5 / 1125.0;
+  const Session session = make_session(time_delta);
+  mvmt::TapDetector detector = make_detector(DOUBLE_TIME, time_delta);
+  Outcome outcome = run(session, detector);
+  report("225 Hz, double taps", outcome, detector, time_delta);
+  TEST_ASSERT_EQUAL(EVENTS, outcome.singles);
+  TEST_ASSERT_EQUAL(EVENTS, outcome.doubles);
+  TEST_ASSERT_EQUAL(0, outcome.flick_clicks);
+  TEST_ASSERT_TRUE(outcome.worst_single <= detector.latency(mvmt::Tap::SINGLE));
+  TEST_ASSERT_TRUE(outcome.worst_double <= detector.latency(mvmt::Tap::DOUBLE));
+}
+
+void test_turning_double_taps_off_reports_waiting_tap() {
+  // Switching modes mid-wait still reports the tap the detector was holding back, once its window runs out
+  constexpr double time_delta = 5 / 1125.0;
+  const Session session = make_session(time_delta);
+  mvmt::TapDetector detector = make_detector(DOUBLE_TIME, time_delta);
+  std::size_t i = session.starts[0];
+  for (; i < session.starts[0] + detector.latency(mvmt::Tap::DOUBLE); i++) {
+    TEST_ASSERT_TRUE(detector.add_measurement(session.samples[i]) == mvmt::Tap::NONE);
+  }
+  detector.set_double_time(0, time_delta);
+  TEST_ASSERT_TRUE(detector.add_measurement(session.samples[i]) == mvmt::Tap::SINGLE);
+}
+
+void test_tap_detector_benchmark() {
+  constexpr double time_delta = 5 / 1125.0;
+  const Session session = make_session(time_delta);
+  double fastest = INFINITY;
+  int taps = 0;
+  for (int pass = 0; pass < 15; pass++) {
+    mvmt::TapDetector detector = make_detector(DOUBLE_TIME, time_delta);
+    auto start = std::chrono::steady_clock::now();
+    for (const Eigen::Vector3f &sample : session.samples) {
+      taps += detector.add_measurement(sample) != mvmt::Tap::NONE;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    fastest = std::min(fastest, std::chrono::duration<double, std::nano>(elapsed).count() / session.samples.size());
+  }
+  // Keep the outputs observable so the loop can't be optimized away
+  TEST_ASSERT_TRUE(taps > 0);
+  char message[64];
+  snprintf(message, sizeof(message), "tap detection: %.1f ns/sample", fastest);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_taps_click_within_bound);
+  RUN_TEST(test_double_taps_click_within_bound);
+  RUN_TEST(test_turning_double_taps_off_reports_waiting_tap);
+  RUN_TEST(test_tap_detector_benchmark);
+  return UNITY_END();
+}
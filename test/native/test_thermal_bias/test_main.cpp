@@ -0,0 +1,160 @@
+#include <ArduinoEigen/Eigen/Dense>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unity.h>
+
+#include "bias_estimator.h"
+#include "thermal_bias.h"
+
+// Thermal bias model and gyroscope bias learning as configured in main.cpp, sampled at 225 Hz
+constexpr float TIME_DELTA = 5 / 1125.0;
+constexpr float LOW_TEMPERATURE = 10;
+constexpr float HIGH_TEMPERATURE = 50;
+constexpr std::size_t BINS = 17;
+constexpr float BIN_WIDTH = (HIGH_TEMPERATURE - LOW_TEMPERATURE) / (BINS - 1);
+constexpr float LEARN_TIME = 10;
+constexpr float STILL_THRESHOLD = 0.035;
+constexpr float MAX_BIAS = 0.2;
+constexpr float STILL_TIME = 0.25;
+constexpr float BIAS_TIME_CONSTANT = 2.0;
+
+using model_t = mvmt::ThermalBiasModel<Eigen::Vector3f, BINS>;
+
+model_t make_model() {
+  return model_t(LOW_TEMPERATURE, HIGH_TEMPERATURE, LEARN_TIME, TIME_DELTA, Eigen::Vector3f::Zero());
+}
+
+/// @brief The temperature of a table entry.
+float temperature_of(std::size_t index) {
+  return LOW_TEMPERATURE + index * BIN_WIDTH;
+}
+
+/// @brief Teach the model a constant reading at a temperature for a while.
+void learn_at(model_t &model, float temperature, const Eigen::Vector3f &reading, float seconds) {
+  model.set_temperature(temperature);
+  for (int i = 0; i < seconds / TIME_DELTA; i++) {
+    model.learn(reading);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_learn_shares_between_neighbours() {
+  model_t model = make_model();
+  // A quarter of the way from entry 6 to entry 7, three quarters of each reading go to entry 6
+  model.set_temperature(temperature_of(6) + BIN_WIDTH / 4);
+  const Eigen::Vector3f reading(0.01, -0.02, 0.03);
+  for (int i = 0; i < 100; i++) {
+    model.learn(reading);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 75, model.m_weights[6]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 25, model.m_weights[7]);
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, model.m_weights[5]);
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, model.m_weights[8]);
+  // Each entry averages only the readings it was given, so both hold the reading itself
+  TEST_ASSERT_TRUE(model.m_table[6].isApprox(reading, 1e-5f));
+  TEST_ASSERT_TRUE(model.m_table[7].isApprox(reading, 1e-5f));
+  // Right on an entry, its neighbours learn nothing
+  model.set_temperature(temperature_of(10));
+  model.learn(reading);
+  TEST_ASSERT_EQUAL_DOUBLE(1.0, model.m_weights[10]);
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, model.m_weights[11]);
+}
+
+void test_bias_holds_flat_beyond_learned_entries() {
+  model_t model = make_model();
+  TEST_ASSERT_TRUE(model.bias(25).isZero());
+  const Eigen::Vector3f cool(0.01, 0.0, -0.01), warm(0.03, 0.01, 0.01);
+  learn_at(model, temperature_of(4), cool, LEARN_TIME);
+  learn_at(model, temperature_of(8), warm, LEARN_TIME);
+  // Outside the learned span, the nearest learned entry holds rather than extrapolating a trend from two points
+  TEST_ASSERT_TRUE(model.bias(LOW_TEMPERATURE - 5).isApprox(cool));
+  TEST_ASSERT_TRUE(model.bias(temperature_of(2)).isApprox(cool));
+  TEST_ASSERT_TRUE(model.bias(temperature_of(12)).isApprox(warm));
+  TEST_ASSERT_TRUE(model.bias(HIGH_TEMPERATURE + 5).isApprox(warm));
+  // Between them, the unlearned entries are skipped and the bias is interpolated across the whole gap
+  TEST_ASSERT_TRUE(model.bias(temperature_of(5)).isApprox(cool + (warm - cool) / 4));
+  TEST_ASSERT_TRUE(model.bias(temperature_of(6) + BIN_WIDTH / 2).isApprox(cool + (warm - cool) * 5 / 8));
+}
+
+void test_entries_need_time_before_use() {
+  model_t model = make_model();
+  // A glimpse of stillness at a temperature is too little to trust
+  learn_at(model, temperature_of(6), Eigen::Vector3f(0.02, 0, 0), 0.05f * LEARN_TIME);
+  TEST_ASSERT_TRUE(model.bias(temperature_of(6)).isZero());
+  learn_at(model, temperature_of(6), Eigen::Vector3f(0.02, 0, 0), 0.05f * LEARN_TIME);
+  TEST_ASSERT_FALSE(model.bias(temperature_of(6)).isZero());
+}
+
+/// @brief Simulate a session: the board warms from 25 to 35 degrees C while alternately lying still and being used,
+/// then cools back down while in constant use.
+/// @param use_model Whether the thermal model removes bias ahead of the bias estimator
+/// @param max_error Set to the largest error in the removed bias while cooling, in rad/s
+/// @return The RMS error in the removed bias while cooling, in rad/s
+double cooling_error(bool use_model, double &max_error) {
+  constexpr float DRIFT = 0.05f * M_PI / 180; // Bias change per degree C, in rad/s
+  constexpr float PHASE_TIME = 200;           // Seconds of warming, and then of cooling
+  const Eigen::Vector3f base_bias(0.01, -0.02, 0.015), drift(DRIFT, -0.5f * DRIFT, DRIFT);
+  std::mt19937 generator(20948);
+  std::normal_distribution<float> noise(0.0f, 0.003f);
+  model_t model = make_model();
+  mvmt::BiasEstimator<Eigen::Vector3f> estimator(STILL_THRESHOLD, MAX_BIAS, STILL_TIME, BIAS_TIME_CONSTANT, TIME_DELTA,
+                                                 Eigen::Vector3f::Zero());
+  double sum = 0;
+  std::size_t count = 0;
+  max_error = 0;
+  for (int i = 0; i < 2 * PHASE_TIME / TIME_DELTA; i++) {
+    float t = i * TIME_DELTA;
+    bool cooling = t >= PHASE_TIME;
+    float temperature = cooling ? 35 - 10 * (t - PHASE_TIME) / PHASE_TIME : 25 + 10 * t / PHASE_TIME;
+    // Warming, the board lies still for 10 s out of every 20
+    bool still = !cooling && std::fmod(t, 20.0f) < 10;
+    Eigen::Vector3f rate = still ? Eigen::Vector3f::Zero()
+                                 : Eigen::Vector3f(std::sin(2 * t), std::cos(1.3f * t), 0.5f * std::sin(0.7f * t));
+    Eigen::Vector3f bias = base_bias + drift * (temperature - 25);
+    Eigen::Vector3f reading = rate + bias + Eigen::Vector3f(noise(generator), noise(generator), noise(generator));
+    // The sensor task's order: the model moves to the temperature and learns while still, then removes its bias
+    // before the estimator sees the reading
+    Eigen::Vector3f removed;
+    if (use_model) {
+      model.set_temperature(temperature);
+      if (still)
+        model.learn(reading);
+      model.add_measurement(reading);
+      estimator.add_measurement(model.get_current());
+      removed = model.bias() + estimator.get_current();
+    } else {
+      estimator.add_measurement(reading);
+      removed = estimator.get_current();
+    }
+    if (cooling) {
+      double error = (removed - bias).norm();
+      sum += error * error;
+      count++;
+      max_error = std::max(max_error, error);
+    }
+  }
+  return std::sqrt(sum / count);
+}
+
+void test_model_follows_temperature_while_moving() {
+  double without_max, with_max;
+  double without = cooling_error(false, without_max), with = cooling_error(true, with_max);
+  char message[112];
+  snprintf(message, sizeof(message), "bias error while cooling: RMS %.2f vs %.2f mrad/s, max %.2f vs %.2f mrad/s",
+           1000 * without, 1000 * with, 1000 * without_max, 1000 * with_max);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.5 * without, with);
+  TEST_ASSERT_LESS_THAN_DOUBLE(0.5 * without_max, with_max);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_learn_shares_between_neighbours);
+  RUN_TEST(test_bias_holds_flat_beyond_learned_entries);
+  RUN_TEST(test_entries_need_time_before_use);
+  RUN_TEST(test_model_follows_temperature_while_moving);
+  return UNITY_END();
+}
@@ -0,0 +1,124 @@
+// Measures what one sample costs through Madgwick fusion and through tilt smoothing. Runs on the board, where it counts
+// CPU cycles, and on the host, where it times in nanoseconds.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <unity.h>
+
+#include "gauss_filter.h"
+#include "madgwick.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+const char *const TICK_UNIT = "cycles";
+uint32_t now_ticks() { return ESP.getCycleCount(); }
+double ticks_per_second() { return getCpuFrequencyMhz() * 1e6; }
+#else
+#include <chrono>
+const char *const TICK_UNIT = "ns";
+uint32_t now_ticks() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+double ticks_per_second() { return 1e9; }
+#endif
+
+// Sampling and smoothing as configured in main.cpp, and fusion as configured by FUSION_POINTING
+constexpr double TIME_DELTA = 5 / 1125.0;
+constexpr double ACCEL_STDDEV = 0.025;
+constexpr double ACCEL_Z_CUTOFF = 2;
+constexpr std::size_t ACCEL_TAPS = mvmt::gauss_table_length(ACCEL_STDDEV, ACCEL_Z_CUTOFF, TIME_DELTA);
+constexpr float FUSION_GAIN = 0.05;
+// Each path gets at most this share of the time between samples, leaving the rest for reporting and the display
+constexpr double SAMPLE_BUDGET = 0.1;
+constexpr std::size_t SAMPLES = 256;
+constexpr int PASSES = 8;
+
+Eigen::Vector3f gyro[SAMPLES];
+Eigen::Vector3f accel[SAMPLES];
+Eigen::Vector3f mag[SAMPLES];
+
+/// @brief Fill the sample buffers with a slow tumble, so every update does real work.
+void make_samples() {
+  for (std::size_t i = 0; i < SAMPLES; i++) {
+    float t = i * TIME_DELTA;
+    gyro[i] = Eigen::Vector3f(0.4f * std::sin(3 * t), 0.3f * std::cos(2 * t), 0.2f);
+    accel[i] = Eigen::Vector3f(0.3f * std::sin(t), 0.2f * std::cos(t), 0.9f) * 1000;
+    mag[i] = Eigen::Vector3f(0.25f, 0.05f * std::sin(t), -0.4f) * 100;
+  }
+}
+
+/// @brief Time a per-sample update over the sample buffers, report its mean cost and check it fits the budget.
+template <typename Update> void benchmark(const char *name, Update update) {
+  update(0); // Prime the filter, so its seeding branch isn't timed
+  uint32_t start = now_ticks();
+  for (int pass = 0; pass < PASSES; pass++) {
+    for (std::size_t i = 0; i < SAMPLES; i++) {
+      update(i);
+    }
+  }
+  uint32_t ticks = (now_ticks() - start) / (PASSES * SAMPLES);
+  char message[80];
+  snprintf(message, sizeof(message), "%s: %u %s per sample", name, unsigned(ticks), TICK_UNIT);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_UINT32(uint32_t(SAMPLE_BUDGET * TIME_DELTA * ticks_per_second()), ticks);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_madgwick_nine_axis() {
+  mvmt::MadgwickFilter<float> fusion(FUSION_GAIN);
+  benchmark("Madgwick, nine axes", [&](std::size_t i) { fusion.update(gyro[i], accel[i], mag[i], TIME_DELTA); });
+  TEST_ASSERT_TRUE(std::isfinite(fusion.orientation().w()));
+}
+
+void test_madgwick_six_axis() {
+  mvmt::MadgwickFilter<float> fusion(FUSION_GAIN);
+  benchmark("Madgwick, six axes", [&](std::size_t i) { fusion.update(gyro[i], accel[i], TIME_DELTA); });
+  TEST_ASSERT_TRUE(std::isfinite(fusion.orientation().w()));
+}
+
+void test_tilt_double() {
+  static constexpr auto taps = mvmt::gauss_kernel<double, ACCEL_TAPS>(ACCEL_STDDEV, ACCEL_Z_CUTOFF, TIME_DELTA);
+  mvmt::GaussianFilter<Eigen::Vector3d> filter(taps, Eigen::Vector3d::Zero());
+  Eigen::Vector3d sink = Eigen::Vector3d::Zero();
+  benchmark("Tilt smoothing, double", [&](std::size_t i) {
+    filter.add_measurement(accel[i].cast<double>());
+    sink += filter.get_current();
+  });
+  TEST_ASSERT_TRUE(std::isfinite(sink.sum()));
+}
+
+void test_tilt_float() {
+  static constexpr auto taps = mvmt::gauss_kernel<float, ACCEL_TAPS>(ACCEL_STDDEV, ACCEL_Z_CUTOFF, TIME_DELTA);
+  mvmt::GaussianFilter<Eigen::Vector3f> filter(taps, Eigen::Vector3f::Zero());
+  Eigen::Vector3f sink = Eigen::Vector3f::Zero();
+  benchmark("Tilt smoothing, float", [&](std::size_t i) {
+    filter.add_measurement(accel[i]);
+    sink += filter.get_current();
+  });
+  TEST_ASSERT_TRUE(std::isfinite(sink.sum()));
+}
+
+int run_tests() {
+  make_samples();
+  UNITY_BEGIN();
+  RUN_TEST(test_madgwick_nine_axis);
+  RUN_TEST(test_madgwick_six_axis);
+  RUN_TEST(test_tilt_double);
+  RUN_TEST(test_tilt_float);
+  return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000); // Give the test runner time to open the serial port
+  run_tests();
+}
+
+void loop() {}
+#else
+int main() { return run_tests(); }
+#endif
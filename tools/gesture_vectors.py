@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""Write the fixed test vectors that check mvmt::GestureClassifier against the Python reference in train_gestures.py.
+
+Each vector is one window of decimated samples of a synthetic gesture, generated from a fixed seed. The shipped model is
+read back from include/gesture_model.h, and each window's features, quantized scores and class are computed the way
+train_gestures.py computes them. Raw vectors also start from raw IMU counts at a sensor profile's sample rate and gyro
+range, and are averaged down the way the firmware decimates them. The native test test/native/test_gesture_model then
+checks that the firmware's decimation, integer features and inference reproduce them bit for bit, and that the model
+recognizes each gesture. Rerun this whenever the model is retrained:
+
+    python3 tools/gesture_vectors.py [--model include/gesture_model.h] [--output test/native/...]
+
+Only the Python standard library is needed.
+"""
+
+import argparse
+import math
+import os
+import random
+import re
+import sys
+
+import train_gestures as tg
+
+HIDDEN = 16
+GRAVITY = 1024  # Decimated accelerometer counts per g
+SAMPLE_RATE = 56.25  # Rate in Hz of decimated samples
+SAMPLE_LIMIT = 4096  # Largest magnitude of a decimated sample
+NOISE = 3  # Standard deviation of the sensor noise, in decimated counts
+
+
+def read_model(path):
+    """Parse a header written by train_gestures.py back into its offsets, scales and model."""
+    with open(path) as header:
+        source = header.read()
+    body = source[source.index("GESTURE_MODEL = {") : source.index("};")]
+    values = iter(int(v) for v in re.findall(r"-?\d+", re.sub(r"//[^\n]*", "", body)))
+    take = lambda count: [next(values) for _ in range(count)]
+    offset, scale = take(tg.FEATURES), take(tg.FEATURES)
+    model = {"hidden_weights": [take(tg.FEATURES) for _ in range(HIDDEN)], "hidden_bias": take(HIDDEN)}
+    model["hidden_multiplier"], model["hidden_shift"] = take(2)
+    model["output_weights"] = [take(HIDDEN) for _ in tg.CLASSES]
+    model["output_bias"] = take(len(tg.CLASSES))
+    (model["margin"],) = take(1)
+    if next(values, None) is not None:
+        sys.exit(f"{path} doesn't hold a {tg.FEATURES}-{HIDDEN}-{len(tg.CLASSES)} network")
+    return offset, scale, model
+
+
+def scores(model, q):
+    """The output layer of train_gestures.classify(), before the class is picked."""
+    active = [
+        tg.requantize(b + sum(w * v for w, v in zip(row, q)), model["hidden_multiplier"], model["hidden_shift"], 0, 127)
+        for row, b in zip(model["hidden_weights"], model["hidden_bias"])
+    ]
+    return [b + sum(w * a for w, a in zip(row, active)) for row, b in zip(model["output_weights"], model["output_bias"])]
+
+
+def pulse(t, center, width):
+    """A raised-cosine pulse of unit height."""
+    return 0.5 * (1 + math.cos(math.pi * (t - center) / width)) if abs(t - center) < width else 0.0
+
+
+# Each vector: a name, the gesture it shows, and the motion of the six channels over time in seconds. The accelerometer
+# reads +1 g on z when the board lies level, and the gyroscope is in counts at 250 dps.
+VECTORS = [
+    ("level", "none", lambda t: [0, 0, GRAVITY, 0, 0, 0]),
+    ("tilted", "none", lambda t: [300, -200, 960, 0, 0, 0]),
+    ("pointing", "none", lambda t: [300 * math.sin(2 * math.pi * t), 0, GRAVITY, 0, 0, 0]),
+    ("flick left", "flick_left", lambda t: [0, 0, GRAVITY, 0, 0, -8000 * pulse(t, 0.4, 0.1)]),
+    ("slow flick left", "flick_left", lambda t: [0, 0, GRAVITY, 0, 0, -4000 * pulse(t, 0.4, 0.2)]),
+    ("twist", "twist", lambda t: [0, 0, GRAVITY, 0, 3000 * math.sin(2 * math.pi * 3 * t), 0]),
+    ("fast twist", "twist", lambda t: [0, 0, GRAVITY, 0, 3000 * math.sin(2 * math.pi * 4 * t), 0]),
+    (
+        "shake",
+        "shake",
+        lambda t: [0, 1500 * math.sin(6 * math.pi * t), GRAVITY + 800 * math.sin(6 * math.pi * t + 1)]
+        + [300 * math.sin(6 * math.pi * t + 2), 800 * math.sin(6 * math.pi * t + 3), 1500 * math.sin(6 * math.pi * t)],
+    ),
+    (
+        "hard shake",
+        "shake",
+        lambda t: [1500 * math.sin(20 * math.pi * t), 300 * math.sin(20 * math.pi * t + 1)]
+        + [GRAVITY + 3000 * math.sin(20 * math.pi * t + 2), 300 * math.sin(20 * math.pi * t + 3)]
+        + [3000 * math.sin(20 * math.pi * t + 4), 3000 * math.sin(20 * math.pi * t + 5)],
+    ),
+]
+
+
+# Each raw vector: one of VECTORS, and the decimation and gyro shift of the sensor profile it is sampled at, as
+# main.cpp sets them from the profile's sample rate divider and gyro range
+RAW_VECTORS = [
+    ("flick left", 1, 10, 1),  # Low latency: 562.5 Hz, +/-500 dps
+    ("twist", 1, 10, 1),
+    ("shake", 4, 4, 0),  # Balanced: 225 Hz, +/-250 dps
+    ("pointing", 10, 2, 0),  # Low power: 102 Hz, +/-250 dps
+]
+RAW_SHIFT = 4  # Bits GestureFeatures drops from raw accelerometer counts
+
+
+def raw_window(motion, decimation, gyro_shift, rng):
+    """Sample a motion as raw IMU counts, at the rate that decimates to one window, with sensor noise."""
+    time_delta = 1 / (SAMPLE_RATE * decimation)
+    raw = []
+    for i in range(tg.WINDOW * decimation):
+        values = motion(i * time_delta)
+        accel = [round((v + rng.gauss(0, NOISE)) * (1 << RAW_SHIFT)) for v in values[:3]]
+        gyro = [round((v + rng.gauss(0, NOISE)) / (1 << gyro_shift)) for v in values[3:]]
+        raw.append([max(-32768, min(32767, v)) for v in accel + gyro])
+    return raw
+
+
+def decimate(raw, decimation, gyro_shift):
+    """Mirror of GestureFeatures::add_measurement(), averaging raw samples down to decimated ones."""
+    divisor = decimation << RAW_SHIFT
+    samples = []
+    for start in range(0, len(raw), decimation):
+        sums = [sum(s[c] * (1 << gyro_shift if c >= 3 else 1) for s in raw[start : start + decimation]) for c in range(6)]
+        samples.append([max(-SAMPLE_LIMIT, min(SAMPLE_LIMIT, tg.tdiv(v, divisor))) for v in sums])
+    return samples
+
+
+def window(motion, rng):
+    """Sample a window of decimated samples of a motion, with sensor noise, clamped as GestureFeatures clamps them."""
+    return [
+        [max(-SAMPLE_LIMIT, min(SAMPLE_LIMIT, round(v + rng.gauss(0, NOISE)))) for v in motion(i / SAMPLE_RATE)]
+        for i in range(tg.WINDOW)
+    ]
+
+
+def main():
+    here = os.path.dirname(__file__)
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--model", default=os.path.join(here, "..", "include", "gesture_model.h"))
+    parser.add_argument(
+        "--output", default=os.path.join(here, "..", "test", "native", "test_gesture_model", "gesture_vectors.h")
+    )
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    offset, scale, model = read_model(args.model)
+    rng = random.Random(args.seed)
+    entries = []
+    for name, gesture, motion in VECTORS:
+        samples = window(motion, rng)
+        features = tg.window_features(samples)
+        quantized = tg.quantize_input(features, offset, scale)
+        recognized = tg.classify(model, quantized)
+        print(f"{name}: {tg.CLASSES[recognized]}" + ("" if tg.CLASSES[recognized] == gesture else f", not {gesture}"))
+        fields = [
+            f'"{name}"',
+            str(tg.CLASSES.index(gesture)),
+            tg.c_array(samples, 4),
+            tg.c_array(features, 4),
+            tg.c_array(scores(model, quantized), 4),
+            str(recognized),
+        ]
+        entries.append("    {" + ",\n     ".join(fields) + "}")
+    body = ",\n".join(entries)
+
+    arrays, raw_entries = [], []
+    motions = {name: (gesture, motion) for name, gesture, motion in VECTORS}
+    for name, shown, decimation, gyro_shift in RAW_VECTORS:
+        gesture, motion = motions[name]
+        raw = raw_window(motion, decimation, gyro_shift, rng)
+        samples = decimate(raw, decimation, gyro_shift)
+        features = tg.window_features(samples)
+        recognized = tg.classify(model, tg.quantize_input(features, offset, scale))
+        label = f"{name} at {SAMPLE_RATE * decimation:g} Hz, gyro shift {gyro_shift}"
+        print(f"{label}: {tg.CLASSES[recognized]}" + ("" if tg.CLASSES[recognized] == gesture else f", not {gesture}"))
+        array = f"RAW_{len(arrays)}"
+        rows = ",\n".join("    " + tg.c_array(sample, 4) for sample in raw)
+        arrays.append(f"const mvmt::GestureFeatureExtractor::sample_t {array}[] = {{\n{rows}}};")
+        fields = [
+            f'"{label}"',
+            str(decimation),
+            str(gyro_shift),
+            array,
+            f"sizeof({array}) / sizeof({array}[0])",
+            str(tg.CLASSES.index(gesture)),
+            tg.c_array(samples, 4),
+            tg.c_array(features, 4),
+            str(recognized),
+        ]
+        raw_entries.append("    {" + ",\n     ".join(fields) + "}")
+    raw_arrays = "\n".join(arrays)
+    raw_body = ",\n".join(raw_entries)
+    with open(args.output, "w") as header:
+        header.write(
+            f"""#ifndef MVMT_TEST_GESTURE_VECTORS_HPP
+#define MVMT_TEST_GESTURE_VECTORS_HPP
+
+// Generated by tools/gesture_vectors.py from include/gesture_model.h - regenerate whenever the model is retrained
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gesture_model.h"
+
+/// @brief One window of a synthetic gesture, with what the Python reference makes of it.
+struct GestureVector {{
+  const char *name;
+  std::size_t gesture; // The gesture the window shows
+  std::array<mvmt::GestureFeatureExtractor::sample_t, mvmt::GESTURE_WINDOW> samples;
+  mvmt::GestureFeatureExtractor::features_t features;
+  std::array<std::int32_t, {len(tg.CLASSES)}> scores;
+  std::size_t recognized; // The class the Python reference picks
+}};
+
+const GestureVector GESTURE_VECTORS[] = {{
+{body}}};
+
+/// @brief Raw IMU counts of a synthetic gesture at a sensor profile's sample rate, with the window they decimate to and
+/// what the Python reference makes of it.
+struct GestureRawVector {{
+  const char *name;
+  std::size_t decimation; // Raw samples averaged into each decimated sample
+  int gyro_shift;         // Bits the gyroscope is scaled up by, to read as at +/-250 dps
+  const mvmt::GestureFeatureExtractor::sample_t *raw;
+  std::size_t raw_count;
+  std::size_t gesture; // The gesture the window shows
+  std::array<mvmt::GestureFeatureExtractor::sample_t, mvmt::GESTURE_WINDOW> samples;
+  mvmt::GestureFeatureExtractor::features_t features;
+  std::size_t recognized; // The class the Python reference picks
+}};
+
+{raw_arrays}
+
+const GestureRawVector GESTURE_RAW_VECTORS[] = {{
+{raw_body}}};
+
+#endif
+"""
+        )
+    print(f"Wrote {os.path.normpath(args.output)}")
+
+
+if __name__ == "__main__":
+    main()
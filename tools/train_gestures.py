@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+"""Train the gesture classifier from IMU traces recorded on the board, and write it out as include/gesture_model.h.
+
+Record traces by building the firmware with GESTURE_RECORDING defined, which prints every decimated IMU sample to
+Serial as a line "G,ax,ay,az,gx,gy,gz". Save a serial log per gesture, named after the gesture it holds and optionally
+a suffix: none.txt, flick_left-1.txt, twist-desk.txt, shake.txt and so on. Lines that aren't samples are skipped, so a
+raw log will do. A gesture's log should repeat the gesture with pauses in between; the none log should hold everything
+that must not count as a gesture, such as pointing, tilting, tapping, flicking right and putting the board down.
+
+    python3 tools/train_gestures.py traces/ [--output include/gesture_model.h]
+
+Features are computed exactly as mvmt::GestureFeatures does, in integer arithmetic, and the quantized network is
+checked in the same integer arithmetic as mvmt::GestureClassifier, so the accuracy printed is the accuracy on the
+board. Only the Python standard library is needed.
+"""
+
+import argparse
+import math
+import os
+import random
+import sys
+import textwrap
+
+CLASSES = ["none", "flick_left", "twist", "shake"]  # In the order of mvmt::Gesture
+WINDOW = 32  # Decimated samples each set of features summarizes
+HOP = 8  # Decimated samples between sets of features
+CHANNELS = 6
+FEATURES = 4 * CHANNELS
+INPUT_RANGE = 4  # Standard deviations of each feature that the 8-bit inputs span either side of its mean
+
+
+def tdiv(a, b):
+    """Divide integers rounding toward zero, as C++ does."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b > 0) else -q
+
+
+def window_features(samples):
+    """Mirror of GestureFeatures::extract() for one window of decimated samples."""
+    features = [0] * FEATURES
+    half = WINDOW // 2
+    for c in range(CHANNELS):
+        values = [s[c] for s in samples]
+        total = sum(values)
+        mean = tdiv(total, WINDOW)
+        variance = tdiv(sum(v * v for v in values), WINDOW) - mean * mean
+        features[c] = mean
+        features[CHANNELS + c] = math.isqrt(max(0, variance))
+        features[2 * CHANNELS + c] = tdiv(sum(abs(values[i + 1] - values[i]) for i in range(WINDOW - 1)), WINDOW - 1)
+        features[3 * CHANNELS + c] = tdiv(2 * sum(values[half:]) - total, half)
+    return features
+
+
+def read_trace(path):
+    samples = []
+    with open(path) as trace:
+        for line in trace:
+            fields = line.strip().split(",")
+            if len(fields) == CHANNELS + 1 and fields[0] == "G":
+                samples.append([int(f) for f in fields[1:]])
+    return samples
+
+
+def trace_class(name):
+    stem = os.path.splitext(name)[0].lower()
+    matches = [c for c in CLASSES if stem == c or stem.startswith(c + "-")]
+    return CLASSES.index(matches[0]) if matches else None
+
+
+def load_windows(directory, activity_share):
+    """Cut every trace into windows, labelling each window of a gesture's trace with the gesture if it moves at least
+    activity_share as much as the trace's busiest windows, and as no gesture otherwise."""
+    windows = []
+    for name in sorted(os.listdir(directory)):
+        label = trace_class(name)
+        if label is None:
+            print(f"Skipping {name}, which isn't named after a gesture", file=sys.stderr)
+            continue
+        samples = read_trace(os.path.join(directory, name))
+        ends = range(WINDOW - 1, len(samples), HOP)
+        features = [window_features(samples[end - WINDOW + 1 : end + 1]) for end in ends]
+        activity = [sum(f[CHANNELS : 2 * CHANNELS]) for f in features]
+        busy = sorted(activity)[int(0.9 * (len(activity) - 1))] if activity else 0
+        for f, a in zip(features, activity):
+            windows.append((f, label if label and a >= activity_share * busy else 0))
+        print(f"{name}: {len(samples)} samples, {len(features)} windows, {CLASSES[label]}")
+    return windows
+
+
+def quantize_input(features, offset, scale):
+    """Mirror of the input rescale in GestureClassifier::classify()."""
+    return [max(-128, min(127, ((f - o) * s + (1 << 15)) >> 16)) for f, o, s in zip(features, offset, scale)]
+
+
+def forward(params, x):
+    w1, b1, w2, b2 = params
+    hidden = [max(0.0, b + sum(w * v for w, v in zip(row, x))) for row, b in zip(w1, b1)]
+    return hidden, [b + sum(w * h for w, h in zip(row, hidden)) for row, b in zip(w2, b2)]
+
+
+def train(inputs, labels, hidden_size, epochs, rng):
+    """Train a float network with one hidden layer by minibatch Adam on a class-weighted cross entropy."""
+    counts = [max(1, labels.count(c)) for c in range(len(CLASSES))]
+    class_weight = [len(labels) / (len(CLASSES) * n) for n in counts]
+    w1 = [[rng.gauss(0, math.sqrt(2 / FEATURES)) for _ in range(FEATURES)] for _ in range(hidden_size)]
+    w2 = [[rng.gauss(0, math.sqrt(2 / hidden_size)) for _ in range(hidden_size)] for _ in CLASSES]
+    params = [w1, [0.0] * hidden_size, w2, [0.0] * len(CLASSES)]
+    flat = lambda p: [p[0], [p[1]], p[2], [p[3]]]  # Every parameter as a list of rows
+    moments = [[[[0.0] * len(row) for row in rows] for _ in range(2)] for rows in flat(params)]
+    rate, beta1, beta2, step = 0.01, 0.9, 0.999, 0
+    order = list(range(len(inputs)))
+    for epoch in range(epochs):
+        rng.shuffle(order)
+        loss = 0.0
+        for start in range(0, len(order), 32):
+            grads = [[[0.0] * len(row) for row in rows] for rows in flat(params)]
+            for i in order[start : start + 32]:
+                x, y = inputs[i], labels[i]
+                hidden, logits = forward(params, x)
+                top = max(logits)
+                exps = [math.exp(l - top) for l in logits]
+                total = sum(exps)
+                loss -= class_weight[y] * math.log(exps[y] / total)
+                dlogits = [class_weight[y] * (e / total - (k == y)) for k, e in enumerate(exps)]
+                dhidden = [0.0] * hidden_size
+                for k, d in enumerate(dlogits):
+                    grads[3][0][k] += d
+                    for j, h in enumerate(hidden):
+                        grads[2][k][j] += d * h
+                        dhidden[j] += d * params[2][k][j]
+                for j, d in enumerate(dhidden):
+                    if hidden[j] <= 0:
+                        continue
+                    grads[1][0][j] += d
+                    row = grads[0][j]
+                    for i_, v in enumerate(x):
+                        row[i_] += d * v
+            step += 1
+            for rows, grad_rows, (m, v) in zip(flat(params), grads, moments):
+                for row, grad_row, m_row, v_row in zip(rows, grad_rows, m, v):
+                    for k, g in enumerate(grad_row):
+                        m_row[k] = beta1 * m_row[k] + (1 - beta1) * g
+                        v_row[k] = beta2 * v_row[k] + (1 - beta2) * g * g
+                        corrected = m_row[k] / (1 - beta1**step)
+                        row[k] -= rate * corrected / (math.sqrt(v_row[k] / (1 - beta2**step)) + 1e-8)
+        if epoch % 10 == 9 or epoch == epochs - 1:
+            print(f"epoch {epoch + 1}: loss {loss / len(inputs):.4f}")
+    return params
+
+
+def fixed_multiplier(value):
+    """Express a positive scale as a 31-bit multiplier and a right shift."""
+    shift = 31 - math.ceil(math.log2(value))
+    multiplier = round(value * (1 << shift))
+    if multiplier == 1 << 31:
+        multiplier, shift = multiplier >> 1, shift - 1
+    return multiplier, shift
+
+
+def quantize(params, inputs, margin):
+    """Quantize a float network to 8-bit weights and activations, matching GestureModel."""
+    w1, b1, w2, b2 = params
+    # Inputs are quantized as q / 127, so a hidden accumulator of 8-bit products is worth weight_scale / 127 each
+    w1_scale = max(abs(w) for row in w1 for w in row) / 127
+    w2_scale = max(abs(w) for row in w2 for w in row) / 127
+    hidden_peak = max(max(forward(params, x)[0]) for x in inputs)
+    hidden_scale = max(hidden_peak, 1e-6) / 127
+    multiplier, shift = fixed_multiplier(w1_scale / 127 / hidden_scale)
+    return {
+        "hidden_weights": [[round(w / w1_scale) for w in row] for row in w1],
+        "hidden_bias": [round(b / (w1_scale / 127)) for b in b1],
+        "hidden_multiplier": multiplier,
+        "hidden_shift": shift,
+        "output_weights": [[round(w / w2_scale) for w in row] for row in w2],
+        "output_bias": [round(b / (w2_scale * hidden_scale)) for b in b2],
+        "margin": math.ceil(margin / (w2_scale * hidden_scale)),
+    }
+
+
+def requantize(value, multiplier, shift, low, high):
+    return max(low, min(high, (value * multiplier + (1 << (shift - 1))) >> shift))
+
+
+def classify(model, q):
+    """Mirror of GestureClassifier::classify() on quantized inputs."""
+    active = [
+        requantize(b + sum(w * v for w, v in zip(row, q)), model["hidden_multiplier"], model["hidden_shift"], 0, 127)
+        for row, b in zip(model["hidden_weights"], model["hidden_bias"])
+    ]
+    rows = zip(model["output_weights"], model["output_bias"])
+    scores = [b + sum(w * a for w, a in zip(row, active)) for row, b in rows]
+    best = max(range(len(scores)), key=lambda k: (scores[k], -k))
+    runner_up = max(s for k, s in enumerate(scores) if k != best)
+    return best if scores[best] - runner_up >= model["margin"] else 0
+
+
+def report(title, model, quantized, labels):
+    confusion = [[0] * len(CLASSES) for _ in CLASSES]
+    for q, y in zip(quantized, labels):
+        confusion[y][classify(model, q)] += 1
+    correct = sum(confusion[c][c] for c in range(len(CLASSES)))
+    print(f"{title}: {correct}/{len(labels)} windows correct ({100 * correct / max(1, len(labels)):.1f}%)")
+    print("  " + " ".join(f"{c:>10}" for c in ["true \\ got"] + CLASSES))
+    for c, row in zip(CLASSES, confusion):
+        print("  " + " ".join(f"{v:>10}" for v in [c] + row))
+
+
+def c_array(values, indent):
+    """Format a list, or a list of lists, as a braced initializer for std::array, wrapped to 120 columns."""
+    if isinstance(values[0], list):
+        rows = [c_array(v, indent + 2) for v in values]
+        return "{{\n" + ",\n".join(" " * (indent + 2) + r for r in rows) + "}}"
+    lines = textwrap.wrap(", ".join(str(v) for v in values), 120 - indent - 8)
+    return "{{" + ("\n" + " " * (indent + 4)).join(lines) + "}}"
+
+
+def write_header(path, model, offset, scale, hidden_size, window_count, source, synthetic):
+    fields = [
+        ("input_offset", offset),
+        ("input_scale", scale),
+        ("hidden_weights", model["hidden_weights"]),
+        ("hidden_bias", model["hidden_bias"]),
+        ("hidden_multiplier", model["hidden_multiplier"]),
+        ("hidden_shift", model["hidden_shift"]),
+        ("output_weights", model["output_weights"]),
+        ("output_bias", model["output_bias"]),
+        ("margin", model["margin"]),
+    ]
+    placeholder = (
+        "\n// PLACEHOLDER: this model has only seen synthetic gestures, never ones recorded on the board, so expect it to"
+        "\n// miss real gestures and mistake ordinary motion for them until it is retrained from recorded traces"
+        if synthetic
+        else ""
+    )
+    body = ",\n".join(f"    // {name}\n    " + (c_array(v, 4) if isinstance(v, list) else str(v)) for name, v in fields)
+    with open(path, "w") as header:
+        header.write(
+            f"""#ifndef MVMT_GESTURE_MODEL_HPP
+#define MVMT_GESTURE_MODEL_HPP
+
+// Generated by tools/train_gestures.py from {window_count} windows of {source} - retrain rather than edit{placeholder}
+
+#include "gesture_classifier.h"
+#include "gesture_features.h"
+
+namespace mvmt {{
+
+constexpr std::size_t GESTURE_WINDOW = {WINDOW}; // Decimated samples each set of features summarizes
+constexpr std::size_t GESTURE_HOP = {HOP};     // Decimated samples between sets of features
+constexpr std::size_t GESTURE_HIDDEN = {hidden_size}; // Neurons in the classifier's hidden layer
+using GestureFeatureExtractor = GestureFeatures<GESTURE_WINDOW, GESTURE_HOP>;
+using GestureNetwork = GestureClassifier<GestureFeatureExtractor::FEATURES, GESTURE_HIDDEN, {len(CLASSES)}>;
+
+constexpr GestureNetwork::model_t GESTURE_MODEL = {{
+{body}}};
+
+}} // namespace mvmt
+
+#endif
+"""
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("traces", help="directory of recorded traces, one file per gesture")
+    parser.add_argument("--output", default=os.path.join(os.path.dirname(__file__), "..", "include", "gesture_model.h"))
+    parser.add_argument("--hidden", type=int, default=16, help="neurons in the hidden layer")
+    parser.add_argument("--epochs", type=int, default=60)
+    parser.add_argument("--margin", type=float, default=2.0, help="least lead in logits for the network to decide")
+    parser.add_argument("--activity", type=float, default=0.5, help="share of a trace's peak motion that is a gesture")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--source", default="recorded traces", help="what the traces are, for the header's comment")
+    parser.add_argument("--synthetic", action="store_true", help="mark the model as a placeholder for a real one")
+    args = parser.parse_args()
+
+    windows = load_windows(args.traces, args.activity)
+    if not windows:
+        sys.exit("No windows of samples found")
+    features = [f for f, _ in windows]
+    labels = [y for _, y in windows]
+    offset, scale = [], []
+    for k in range(FEATURES):
+        column = [f[k] for f in features]
+        mean = sum(column) / len(column)
+        deviation = math.sqrt(sum((v - mean) ** 2 for v in column) / len(column))
+        offset.append(round(mean))
+        scale.append(max(1, round(65536 * 127 / (INPUT_RANGE * max(deviation, 1)))))
+    quantized = [quantize_input(f, offset, scale) for f in features]
+    # Every fifth window is held out, so the accuracy on it shows how well the network generalizes
+    train_set = [i for i in range(len(windows)) if i % 5]
+    held_out = [i for i in range(len(windows)) if not i % 5]
+    params = train(
+        [[v / 127 for v in quantized[i]] for i in train_set],
+        [labels[i] for i in train_set],
+        args.hidden,
+        args.epochs,
+        random.Random(args.seed),
+    )
+    model = quantize(params, [[v / 127 for v in q] for q in quantized], args.margin)
+    report("Training windows", model, [quantized[i] for i in train_set], [labels[i] for i in train_set])
+    report("Held out windows", model, [quantized[i] for i in held_out], [labels[i] for i in held_out])
+    write_header(args.output, model, offset, scale, args.hidden, len(windows), args.source, args.synthetic)
+    print(f"Wrote {os.path.normpath(args.output)} - now rerun tools/gesture_vectors.py to update the native test")
+
+
+if __name__ == "__main__":
+    main()